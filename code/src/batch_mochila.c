@@ -0,0 +1,268 @@
+/**@file   batch_mochila.c
+ * @brief  batch mode: solves all instances of some directories (or some instance files) with some configurations in a pool of threads
+ **/
+#define _GNU_SOURCE
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<dirent.h>
+#include<pthread.h>
+#include<sched.h>
+#include "batch_mochila.h"
+#include "run_mochila.h"
+#include "utils.h"
+
+//#define DEBUG_BATCH 1
+/** one job: instance and configuration */
+typedef struct{
+   char* instance;
+   int config;
+   double size;       /**< estimate of the size of the instance (n * nS) */
+   double time;       /**< CPU time of the job */
+   int status;        /**< 1: solved, 0: error */
+} batchJobT;
+
+/** data shared by the workers */
+typedef struct{
+   char* program;
+   batchConfigT* configs;
+   batchJobT* jobs;
+   int njobs;
+   int next;          /**< next job to solve */
+   int pin;
+   pthread_mutex_t lock;
+} batchDataT;
+
+/** worker data */
+typedef struct{
+   batchDataT* data;
+   int id;
+} batchWorkerT;
+
+static int compareJobs(const void* a, const void* b)
+{
+   double sa = ((batchJobT*) a)->size, sb = ((batchJobT*) b)->size;
+
+   return sa < sb ? 1 : (sa > sb ? -1 : 0);
+}
+
+/** estimate of the size of an instance, from its first line (n nS C) */
+static double instanceSize(char* filename)
+{
+   FILE* fin;
+   int n, nS, C;
+
+   fin = fopen(filename, "r");
+   if(!fin)
+      return -1.0;
+   if(fscanf(fin, "%d %d %d", &n, &nS, &C) != 3)
+      n = nS = 0;
+   fclose(fin);
+   return (double) n*nS;
+}
+
+int batchLoadConfig(char* program, char* instance, batchConfigT* config)
+{
+   FILE* fin;
+   char word[SCIP_MAXSTRLEN];
+
+   // the same arguments of a single run: program instance options...
+   config->argv[0] = program;
+   config->argv[1] = instance;
+   config->argc = 2;
+   fin = fopen(config->filename, "r");
+   if(!fin){
+      printf("\nProblem to open configuration file %s\n", config->filename);
+      return 0;
+   }
+   while(config->argc < BATCH_MAXARGS && fscanf(fin, BATCH_WORD, word) == 1)
+      config->argv[(config->argc)++] = strdup(word);
+   fclose(fin);
+   return setParameters(config->argc, config->argv, &config->param);
+}
+
+void batchFreeConfig(batchConfigT* config)
+{
+   int a;
+
+   for(a=2;a<config->argc;a++)
+      free(config->argv[a]);
+   config->argc = 0;
+   free(config->filename);
+}
+
+/** adds one job by configuration for the instance in path */
+static void addJobs(batchDataT* data, int* size, char* path, int nconfigs)
+{
+   int c;
+
+   for(c=0;c<nconfigs;c++){
+      if(data->njobs == *size){
+         *size *= 2;
+         data->jobs = (batchJobT*) realloc(data->jobs, sizeof(batchJobT)*(*size));
+      }
+      data->jobs[data->njobs].instance = strdup(path);
+      data->jobs[data->njobs].config = c;
+      data->jobs[data->njobs].size = instanceSize(path);
+      data->jobs[data->njobs].time = 0.0;
+      data->jobs[data->njobs].status = 0;
+      data->njobs++;
+   }
+}
+
+/** worker: takes the next job until all of them are solved */
+static void* batchWorker(void* arg)
+{
+   batchWorkerT* worker;
+   batchDataT* data;
+   batchJobT* job;
+   parametersT param;
+   cpu_set_t cpus;
+   double start;
+   int t;
+
+   worker = (batchWorkerT*) arg;
+   data = worker->data;
+   if(data->pin){
+      CPU_ZERO(&cpus);
+      CPU_SET(worker->id % CPU_SETSIZE, &cpus);
+      if(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) != 0)
+         printf("\nBatch: worker %d could not be pinned", worker->id);
+   }
+   for(;;){
+      pthread_mutex_lock(&data->lock);
+      t = data->next++;
+      pthread_mutex_unlock(&data->lock);
+      if(t >= data->njobs)
+         break;
+      job = &data->jobs[t];
+      // runInstance() can change the parameters (modes turned off), so each job has its own copy
+      param = data->configs[job->config].param;
+      start = threadTime();
+      job->status = runInstance(data->program, job->instance, &param, 1, NULL) == SCIP_OKAY;
+      job->time = threadTime() - start;
+      printf("\nBatch: worker %d solved %s with %s in %.2lf s", worker->id, job->instance, data->configs[job->config].filename, job->time);
+      fflush(stdout);
+   }
+   return NULL;
+}
+
+SCIP_RETCODE batchSolve(char* program, char* batchfile)
+{
+   FILE* fin;
+   DIR* dir;
+   struct dirent* entry;
+   batchDataT data;
+   batchWorkerT* workers;
+   pthread_t* threads;
+   char key[SCIP_MAXSTRLEN], value[SCIP_MAXSTRLEN], path[2*SCIP_MAXSTRLEN+2];
+   char** dirs, **files;
+   int c, d, f, t, nconfigs, ndirs, nfiles, nthreads, size;
+
+   fin = fopen(batchfile, "r");
+   if(!fin){
+      printf("\nProblem to open batch file %s\n", batchfile);
+      return SCIP_NOFILE;
+   }
+   nthreads = 1;
+   data.pin = 0;
+   nconfigs = ndirs = nfiles = 0;
+   data.configs = (batchConfigT*) malloc(sizeof(batchConfigT));
+   dirs = (char**) malloc(sizeof(char*));
+   files = (char**) malloc(sizeof(char*));
+   while(fscanf(fin, BATCH_WORD " " BATCH_WORD, key, value) == 2){
+      if(!strcmp(key, "threads"))
+         nthreads = atoi(value) > 0 ? atoi(value) : 1;
+      else if(!strcmp(key, "pin"))
+         data.pin = atoi(value);
+      else if(!strcmp(key, "config")){
+         data.configs = (batchConfigT*) realloc(data.configs, sizeof(batchConfigT)*(nconfigs+1));
+         data.configs[nconfigs].argc = 0;
+         data.configs[nconfigs++].filename = strdup(value);
+      }
+      else if(!strcmp(key, "dir")){
+         dirs = (char**) realloc(dirs, sizeof(char*)*(ndirs+1));
+         dirs[ndirs++] = strdup(value);
+      }
+      else if(!strcmp(key, "instance")){
+         files = (char**) realloc(files, sizeof(char*)*(nfiles+1));
+         files[nfiles++] = strdup(value);
+      }
+      else
+         printf("\nBatch: unknown key %s ignored", key);
+   }
+   fclose(fin);
+
+   // jobs: each instance of the directories and each instance file with each configuration
+   data.njobs = 0;
+   size = 16;
+   data.jobs = (batchJobT*) malloc(sizeof(batchJobT)*size);
+   for(d=0;d<ndirs;d++){
+      dir = opendir(dirs[d]);
+      if(!dir){
+         printf("\nBatch: problem to open directory %s", dirs[d]);
+         continue;
+      }
+      while((entry = readdir(dir)) != NULL){
+         if(entry->d_name[0] == '.' || !strcmp(entry->d_name, "readme.txt"))
+            continue;
+         (void) snprintf(path, sizeof(path), "%s/%s", dirs[d], entry->d_name);
+         addJobs(&data, &size, path, nconfigs);
+      }
+      closedir(dir);
+   }
+   for(f=0;f<nfiles;f++)
+      addJobs(&data, &size, files[f], nconfigs);
+   // each configuration is checked once (the stamp file is created or compared here, not by the workers)
+   for(c=0;c<nconfigs;c++){
+      for(t=0;t<data.njobs && data.jobs[t].config != c;t++)
+         ;
+      if(t == data.njobs || !batchLoadConfig(program, data.jobs[t].instance, &data.configs[c])){
+         printf("\nBatch: configuration %s is invalid, its jobs are skipped", data.configs[c].filename);
+         for(t=0;t<data.njobs;t++)
+            if(data.jobs[t].config == c)
+               data.jobs[t].size = -1.0;
+      }
+   }
+   // longest first; the skipped jobs (size < 0) are at the end
+   qsort(data.jobs, data.njobs, sizeof(batchJobT), compareJobs);
+   while(data.njobs > 0 && data.jobs[data.njobs-1].size < 0){
+      data.njobs--;
+      free(data.jobs[data.njobs].instance);
+   }
+   printf("\nBatch: %d jobs (%d directories, %d instance files, %d configurations) with %d workers\n", data.njobs, ndirs, nfiles, nconfigs, nthreads);
+
+   data.program = program;
+   data.next = 0;
+   pthread_mutex_init(&data.lock, NULL);
+   threads = (pthread_t*) malloc(sizeof(pthread_t)*nthreads);
+   workers = (batchWorkerT*) malloc(sizeof(batchWorkerT)*nthreads);
+   for(t=0;t<nthreads;t++){
+      workers[t].data = &data;
+      workers[t].id = t;
+      pthread_create(&threads[t], NULL, batchWorker, &workers[t]);
+   }
+   for(t=0;t<nthreads;t++)
+      pthread_join(threads[t], NULL);
+   pthread_mutex_destroy(&data.lock);
+
+   for(t=0;t<data.njobs;t++){
+      if(!data.jobs[t].status)
+         printf("\nBatch: job %s with %s failed", data.jobs[t].instance, data.configs[data.jobs[t].config].filename);
+      free(data.jobs[t].instance);
+   }
+   printf("\n");
+   for(c=0;c<nconfigs;c++)
+      batchFreeConfig(&data.configs[c]);
+   for(d=0;d<ndirs;d++)
+      free(dirs[d]);
+   free(dirs);
+   for(f=0;f<nfiles;f++)
+      free(files[f]);
+   free(files);
+   free(workers);
+   free(threads);
+   free(data.jobs);
+   free(data.configs);
+   return SCIP_OKAY;
+}
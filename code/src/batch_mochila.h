@@ -0,0 +1,44 @@
+/**@file   batch_mochila.h
+ * @brief  batch mode: solves all instances of some directories (or some instance files) with some configurations in a pool of threads
+ *
+ * Usage: mochila --batch <batch file>. The batch file has the lines
+ *    threads <n>          total of workers (default 1)
+ *    pin <0|1>            pins worker t in the core t (default 0)
+ *    config <file>        configuration file, with the same options of the command line (one or more)
+ *    dir <directory>      directory with instance files (one or more)
+ *    instance <file>      one instance file (one or more), as the fixed instance set of the benchmark (bench/)
+ * Each pair (instance, configuration) is a job. Each configuration is checked once (setParameters() and its stamp
+ * file), and the jobs are solved by the workers with independent SCIP environments, the largest instances first.
+ * Each job writes the same .out and .sol files of a single run.
+ **/
+#ifndef __BATCH_MOCHILA__
+#define __BATCH_MOCHILA__
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#define BATCH_MAXARGS 200 /**< maximum of words in a configuration file */
+#define BATCH_MAXWORD 1023 /**< maximum length of a word read by fscanf() in buffers of SCIP_MAXSTRLEN chars */
+#if BATCH_MAXWORD >= SCIP_MAXSTRLEN
+#error "BATCH_MAXWORD must be less than SCIP_MAXSTRLEN"
+#endif
+#define BATCH_STR2(x) #x
+#define BATCH_STR(x) BATCH_STR2(x)
+#define BATCH_WORD "%" BATCH_STR(BATCH_MAXWORD) "s" /**< fscanf() format of a word, as "%1023s" */
+
+/** configuration: arguments of the command line and parameters checked by setParameters() */
+typedef struct{
+   char* filename;
+   int argc;
+   char* argv[BATCH_MAXARGS];
+   parametersT param;
+} batchConfigT;
+
+// reads config->filename (words separated by blanks) and checks it with setParameters() for the given instance.
+// Returns 1 if the configuration is valid. The strings of argv are kept (param points to them)
+int batchLoadConfig(char* program, char* instance, batchConfigT* config);
+// frees the strings of the configuration
+void batchFreeConfig(batchConfigT* config);
+
+// runs the batch file
+SCIP_RETCODE batchSolve(char* program, char* batchfile);
+#endif
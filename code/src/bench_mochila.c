@@ -0,0 +1,273 @@
+/**@file   bench_mochila.c
+ * @brief  compares the .out files of a benchmark run with a baseline and gates the performance regressions
+ *
+ * Usage: bench_mochila [options] <baseline file> <output directory>
+ *    --update             rewrites the baseline file with the results of the output directory
+ *    --program <name>     program name in the .out files (default mochila)
+ *    --primal_tol <r>     relative loss of the primal bound allowed (default 0.001)
+ *    --gap_tol <a>        absolute increase of the gap allowed (default 0.01)
+ *    --time_tol <r>       relative increase of the time to the best solution allowed (default 0.5) ...
+ *    --time_abs <s>       ... plus an absolute slack in seconds (default 5)
+ *    --nodes_tol <r>      relative increase of the nodes allowed, only for instances solved to optimality (default 0.5)
+ *
+ * The baseline has one line "instance;config;primal;gap;time to best;nodes" by job (lines with # are comments). The job
+ * writes <output directory>/<instance>-<program>-<config>.out, whose fields are the ones of printStatistic(). The primal
+ * bound is maximized. A line with only "instance;config" is a job without baseline yet: it is not compared until
+ * "make bench-baseline" measures it on the benchmark machine (a warning is printed). A summary table is printed, and the
+ * exit code is 1 if some job is missing or regressed.
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#define BENCH_MAXLINE 8192
+
+//#define DEBUG_BENCH 1
+
+/** results of one job */
+typedef struct{
+   char instance[256];
+   char config[256];
+   double primal;
+   double gap;
+   double ttb;        /**< time to the best solution */
+   double nodes;
+   int measured;      /**< 0: the baseline of the job was not measured yet */
+} benchResultT;
+
+/** tolerances of the comparison */
+typedef struct{
+   double primal;
+   double gap;
+   double time;
+   double timeabs;
+   double nodes;
+} benchTolT;
+
+// returns field f (0, 1, ...) of a line with fields separated by ';' in value (empty if there is no field f)
+static void getField(const char* line, int f, char* value, int size)
+{
+   const char* end;
+   int len;
+
+   for(; f > 0 && line != NULL; f--){
+      line = strchr(line, ';');
+      if(line != NULL)
+         line++;
+   }
+   value[0] = '\0';
+   if(line == NULL)
+      return;
+   end = strpbrk(line, ";\n");
+   len = end != NULL ? (int) (end - line) : (int) strlen(line);
+   if(len >= size)
+      len = size-1;
+   memcpy(value, line, len);
+   value[len] = '\0';
+}
+
+static double getDouble(const char* line, int f)
+{
+   char value[256];
+
+   getField(line, f, value, sizeof(value));
+   return atof(value);
+}
+
+// reads the .out file of the job (instance, config) in result; returns 0 if it does not exist
+static int readOut(const char* dir, const char* program, benchResultT* result)
+{
+   char filename[1024], line[BENCH_MAXLINE];
+   FILE* fin;
+
+   snprintf(filename, sizeof(filename), "%s/%s-%s-%s.out", dir, result->instance, program, result->config);
+   fin = fopen(filename, "r");
+   if(!fin)
+      return 0;
+   if(fgets(line, sizeof(line), fin) == NULL){
+      fclose(fin);
+      return 0;
+   }
+   fclose(fin);
+   // name;n;nS;C;rootlpiter;time;dual;primal;gap;rootdual;nodes;nodesleft;solvingtime;totaltime;mem;cols;status;bestsol in node;time;...
+   result->primal = getDouble(line, 7);
+   result->gap = getDouble(line, 8);
+   result->nodes = getDouble(line, 10);
+   result->ttb = getDouble(line, 18);
+#ifdef DEBUG_BENCH
+   printf("\n%s: primal %lf gap %lf nodes %.0lf ttb %lf", filename, result->primal, result->gap, result->nodes, result->ttb);
+#endif
+   return 1;
+}
+
+// reads the baseline; returns the total of jobs (-1 if the file does not exist)
+static int readBaseline(const char* filename, benchResultT** baseline)
+{
+   char line[BENCH_MAXLINE], value[256];
+   FILE* fin;
+   int n, size;
+
+   fin = fopen(filename, "r");
+   if(!fin)
+      return -1;
+   n = 0;
+   size = 16;
+   *baseline = (benchResultT*) malloc(sizeof(benchResultT)*size);
+   while(fgets(line, sizeof(line), fin) != NULL){
+      if(line[0] == '#' || line[0] == '\n')
+         continue;
+      if(n == size){
+         size *= 2;
+         *baseline = (benchResultT*) realloc(*baseline, sizeof(benchResultT)*size);
+      }
+      getField(line, 0, (*baseline)[n].instance, sizeof((*baseline)[n].instance));
+      getField(line, 1, (*baseline)[n].config, sizeof((*baseline)[n].config));
+      (*baseline)[n].primal = getDouble(line, 2);
+      (*baseline)[n].gap = getDouble(line, 3);
+      (*baseline)[n].ttb = getDouble(line, 4);
+      (*baseline)[n].nodes = getDouble(line, 5);
+      getField(line, 2, value, sizeof(value));
+      (*baseline)[n].measured = value[0] != '\0';
+      n++;
+   }
+   fclose(fin);
+   return n;
+}
+
+static int writeBaseline(const char* filename, benchResultT* results, int n)
+{
+   FILE* fout;
+   int j;
+
+   fout = fopen(filename, "w");
+   if(!fout)
+      return 0;
+   fprintf(fout, "# instance;config;primal;gap;time to best;nodes\n");
+   for(j=0;j<n;j++)
+      fprintf(fout, "%s;%s;%lf;%lf;%lf;%.0lf\n", results[j].instance, results[j].config, results[j].primal, results[j].gap, results[j].ttb, results[j].nodes);
+   fclose(fout);
+   return 1;
+}
+
+// compares the job with its baseline; returns the flags of the regressions in why ("p": primal, "g": gap, "t": time to
+// best, "n": nodes) and 1 if there is some regression
+static int compare(benchResultT* base, benchResultT* run, benchTolT* tol, char* why)
+{
+   why[0] = '\0';
+   if(run->primal < base->primal - tol->primal*(base->primal > 0 ? base->primal : -base->primal) - 1e-6)
+      strcat(why, "p");
+   if(run->gap > base->gap + tol->gap)
+      strcat(why, "g");
+   if(run->ttb > base->ttb*(1.0 + tol->time) + tol->timeabs)
+      strcat(why, "t");
+   // the nodes of the runs stopped by the time limit are not comparable
+   if(base->gap <= 1e-9 && run->nodes > base->nodes*(1.0 + tol->nodes) + 1.0)
+      strcat(why, "n");
+   return why[0] != '\0';
+}
+
+int main(int argc, char** argv)
+{
+   benchResultT* baseline, *runs;
+   benchTolT tol;
+   char* program, why[8];
+   double sumprimal, sumgap;
+   int i, j, n, update, nmissing, nunmeasured, nregressions, nimproved;
+
+   update = 0;
+   program = "mochila";
+   tol.primal = 0.001;
+   tol.gap = 0.01;
+   tol.time = 0.5;
+   tol.timeabs = 5.0;
+   tol.nodes = 0.5;
+   for(i=1;i+2<argc && !strncmp(argv[i], "--", 2);i+=2){
+      if(!strcmp(argv[i], "--update")){
+         update = 1;
+         i--;
+      }
+      else if(!strcmp(argv[i], "--program"))
+         program = argv[i+1];
+      else if(!strcmp(argv[i], "--primal_tol"))
+         tol.primal = atof(argv[i+1]);
+      else if(!strcmp(argv[i], "--gap_tol"))
+         tol.gap = atof(argv[i+1]);
+      else if(!strcmp(argv[i], "--time_tol"))
+         tol.time = atof(argv[i+1]);
+      else if(!strcmp(argv[i], "--time_abs"))
+         tol.timeabs = atof(argv[i+1]);
+      else if(!strcmp(argv[i], "--nodes_tol"))
+         tol.nodes = atof(argv[i+1]);
+      else{
+         printf("\nBench: unknown option %s\n", argv[i]);
+         return 2;
+      }
+   }
+   if(i+2 != argc){
+      printf("\nSintaxe: %s [options] <baseline file> <output directory>\n", argv[0]);
+      return 2;
+   }
+   n = readBaseline(argv[i], &baseline);
+   if(n < 0){
+      printf("\nBench: problem to open baseline file %s\n", argv[i]);
+      return 2;
+   }
+
+   runs = (benchResultT*) malloc(sizeof(benchResultT)*(n > 0 ? n : 1));
+   nmissing = nunmeasured = nregressions = nimproved = 0;
+   sumprimal = sumgap = 0.0;
+   printf("\n%-20s %-28s %14s %14s %8s %8s %9s %9s %10s %10s  %s", "instance", "config", "primal base", "primal run",
+      "gap base", "gap run", "ttb base", "ttb run", "nodes base", "nodes run", "verdict");
+   for(j=0;j<n;j++){
+      runs[j] = baseline[j];
+      if(!readOut(argv[i+1], program, &runs[j])){
+         nmissing++;
+         printf("\n%-20s %-28s %14.2lf %14s %8.4lf %8s %9.2lf %9s %10.0lf %10s  MISSING", baseline[j].instance, baseline[j].config,
+            baseline[j].primal, "*", baseline[j].gap, "*", baseline[j].ttb, "*", baseline[j].nodes, "*");
+         continue;
+      }
+      runs[j].measured = 1;
+      if(!baseline[j].measured){
+         nunmeasured++;
+         printf("\n%-20s %-28s %14s %14.2lf %8s %8.4lf %9s %9.2lf %10s %10.0lf  NO BASELINE", baseline[j].instance, baseline[j].config,
+            "*", runs[j].primal, "*", runs[j].gap, "*", runs[j].ttb, "*", runs[j].nodes);
+         continue;
+      }
+      sumprimal += runs[j].primal - baseline[j].primal;
+      sumgap += runs[j].gap - baseline[j].gap;
+      if(compare(&baseline[j], &runs[j], &tol, why))
+         nregressions++;
+      else if(runs[j].primal > baseline[j].primal + 1e-6 || runs[j].gap < baseline[j].gap - tol.gap)
+         nimproved++;
+      printf("\n%-20s %-28s %14.2lf %14.2lf %8.4lf %8.4lf %9.2lf %9.2lf %10.0lf %10.0lf  %s%s", baseline[j].instance, baseline[j].config,
+         baseline[j].primal, runs[j].primal, baseline[j].gap, runs[j].gap, baseline[j].ttb, runs[j].ttb, baseline[j].nodes, runs[j].nodes,
+         why[0] != '\0' ? "REGRESSION " : "ok", why);
+   }
+   printf("\n\nBench: %d jobs, %d regressions, %d missing, %d without baseline, %d improved; mean primal change %.2lf, mean gap change %.4lf\n",
+      n, nregressions, nmissing, nunmeasured, nimproved, n > nmissing + nunmeasured ? sumprimal/(n-nmissing-nunmeasured) : 0.0,
+      n > nmissing + nunmeasured ? sumgap/(n-nmissing-nunmeasured) : 0.0);
+   printf("Tolerances: primal %.4lf (rel), gap %.4lf (abs), time to best %.2lf (rel) + %.1lf s, nodes %.2lf (rel, optimal only)\n",
+      tol.primal, tol.gap, tol.time, tol.timeabs, tol.nodes);
+
+   if(update){
+      if(nmissing > 0){
+         printf("Bench: baseline not updated (%d jobs missing)\n", nmissing);
+         free(runs);
+         free(baseline);
+         return 1;
+      }
+      if(!writeBaseline(argv[i], runs, n)){
+         printf("Bench: problem to write baseline file %s\n", argv[i]);
+         free(runs);
+         free(baseline);
+         return 2;
+      }
+      printf("Bench: baseline %s updated\n", argv[i]);
+      nregressions = 0;
+   }
+   else if(nunmeasured > 0)
+      printf("Bench: warning: %d jobs without baseline, run \"make bench-baseline\" on the benchmark machine\n", nunmeasured);
+   free(runs);
+   free(baseline);
+   return nregressions > 0 || nmissing > 0 ? 1 : 0;
+}
@@ -0,0 +1,273 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   branch_forfeit.c
+ * @brief  branching rule on the forfeit structure
+ *
+ * Let x*, v* be the LP solution. The rule tries, in this order:
+ *  1. the total of violations: if V* = sum_j v*_j is fractional, sum_j v_j <= floor(V*) and sum_j v_j >= ceil(V*);
+ *  2. a violation variable v_j with fractional value, chosen by d_j * min(frac, 1-frac);
+ *  3. the count of a forfeit set: if c*_j = sum_{i in S_j} x*_i is fractional, sum_{i in S_j} x_i <= floor(c*_j) and
+ *     sum_{i in S_j} x_i >= ceil(c*_j), chosen by d_j * min(frac, 1-frac) and preferring the sets with
+ *     h_j < c*_j < h_j + 1 (the decision whether the set pays the forfeit cost).
+ * If there is nothing to branch on, the rule does not run and the next rule (pscost on x) is called.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "branch_forfeit.h"
+
+//#define DEBUG_BRANCH 1
+#define BRANCHRULE_NAME            "forfeit"
+#define BRANCHRULE_DESC            "branching on the forfeit sets and on the violations"
+#define BRANCHRULE_PRIORITY        2000000 /**< above pscost (1000000 in configScip) */
+#define BRANCHRULE_MAXDEPTH        -1
+#define BRANCHRULE_MAXBOUNDDIST    1.0
+
+#define BRANCH_MINFRAC             0.001 /**< values closer than this to an integer are considered integral */
+
+/*
+ * Data structures
+ */
+
+/** branching rule data */
+struct SCIP_BranchruleData
+{
+   const parametersT*    param;              /**< pointer to the config parameters */
+   SCIP_Longint          nglobal;            /**< branchings on the total of violations */
+   SCIP_Longint          nviol;              /**< branchings on v_j */
+   SCIP_Longint          nset;               /**< branchings on the count of a set */
+};
+
+/*
+ * Local methods
+ */
+
+/** fractionality of a value: min(frac, 1-frac) */
+static
+SCIP_Real fractionality(SCIP_Real val)
+{
+   SCIP_Real frac;
+
+   frac = val - floor(val);
+   return frac < 1.0 - frac ? frac : 1.0 - frac;
+}
+
+/** creates two children: sum vars <= down and sum vars >= down + 1 */
+static
+SCIP_RETCODE branchOnSum(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           name,               /**< name of the branching constraints */
+   SCIP_VAR**            vars,               /**< variables of the sum */
+   int                   nvars,              /**< total of variables */
+   SCIP_Real             down                /**< right hand side of the down child */
+   )
+{
+   SCIP_NODE* child;
+   SCIP_CONS* cons;
+   SCIP_Real* vals;
+   char consname[SCIP_MAXSTRLEN];
+   int i;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &vals, nvars) );
+   for(i=0;i<nvars;i++)
+      vals[i] = 1.0;
+
+   /* down child */
+   SCIP_CALL( SCIPcreateChild(scip, &child, 1.0, SCIPgetLocalTransEstimate(scip)) );
+   (void) SCIPsnprintf(consname, SCIP_MAXSTRLEN, "%s_le_%g", name, down);
+   SCIP_CALL( SCIPcreateConsLinear(scip, &cons, consname, nvars, vars, vals, -SCIPinfinity(scip), down,
+         TRUE, TRUE, TRUE, FALSE, TRUE, TRUE, FALSE, FALSE, FALSE, TRUE) );
+   SCIP_CALL( SCIPaddConsNode(scip, child, cons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   /* up child */
+   SCIP_CALL( SCIPcreateChild(scip, &child, 1.0, SCIPgetLocalTransEstimate(scip)) );
+   (void) SCIPsnprintf(consname, SCIP_MAXSTRLEN, "%s_ge_%g", name, down + 1.0);
+   SCIP_CALL( SCIPcreateConsLinear(scip, &cons, consname, nvars, vars, vals, down + 1.0, SCIPinfinity(scip),
+         TRUE, TRUE, TRUE, FALSE, TRUE, TRUE, FALSE, FALSE, FALSE, TRUE) );
+   SCIP_CALL( SCIPaddConsNode(scip, child, cons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   SCIPfreeBufferArray(scip, &vals);
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of branching rule
+ */
+
+/** copy method for branchrule plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_BRANCHCOPY(branchCopyForfeit)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(branchrule != NULL);
+
+   /* call inclusion method of branching rule */
+   SCIP_CALL( SCIPincludeBranchruleForfeit(scip, SCIPbranchruleGetData(branchrule)->param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of branching rule to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_BRANCHFREE(branchFreeForfeit)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+#ifdef DEBUG_BRANCH
+   printf("\nBranch forfeit: %lld on total of violations, %lld on v_j, %lld on set counts\n", branchruledata->nglobal, branchruledata->nviol, branchruledata->nset);
+#endif
+   SCIPfreeMemory(scip, &branchruledata);
+   SCIPbranchruleSetData(branchrule, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** branching execution method for fractional LP solutions */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpForfeit)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR **vars, **setvars;
+   SCIP_Real val, total, score, bestscore, count, bestcount;
+   instanceT* I;
+   char name[SCIP_MAXSTRLEN];
+   int i, j, best, bestset, boundary, bestboundary;
+
+   *result = SCIP_DIDNOTRUN;
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+
+   /* 1. total of violations */
+   total = 0.0;
+   for(j=0;j<I->nS;j++)
+      total += SCIPgetSolVal(scip, NULL, vars[I->n+j]);
+   if(fractionality(total) > BRANCH_MINFRAC){
+#ifdef DEBUG_BRANCH
+      printf("\nBranch on the total of violations: %lf", total);
+#endif
+      SCIP_CALL( branchOnSum(scip, "violations", vars + I->n, I->nS, floor(total)) );
+      branchruledata->nglobal++;
+      *result = SCIP_BRANCHED;
+      return SCIP_OKAY;
+   }
+
+   /* 2. violation variable v_j */
+   best = -1;
+   bestscore = 0.0;
+   for(j=0;j<I->nS;j++){
+      val = SCIPgetSolVal(scip, NULL, vars[I->n+j]);
+      if(fractionality(val) > BRANCH_MINFRAC){
+         score = I->S[j].d * fractionality(val);
+         if(best < 0 || score > bestscore){
+            best = j;
+            bestscore = score;
+         }
+      }
+   }
+   if(best >= 0){
+#ifdef DEBUG_BRANCH
+      printf("\nBranch on v_%d = %lf", best, SCIPgetSolVal(scip, NULL, vars[I->n+best]));
+#endif
+      SCIP_CALL( SCIPbranchVar(scip, vars[I->n+best], NULL, NULL, NULL) );
+      branchruledata->nviol++;
+      *result = SCIP_BRANCHED;
+      return SCIP_OKAY;
+   }
+
+   /* 3. count of a forfeit set */
+   bestset = -1;
+   bestscore = 0.0;
+   bestcount = 0.0;
+   bestboundary = 0;
+   for(j=0;j<I->nS;j++){
+      count = 0.0;
+      for(i=0;i<I->S[j].n;i++)
+         count += SCIPgetSolVal(scip, NULL, vars[I->S[j].items[i]]);
+      if(fractionality(count) <= BRANCH_MINFRAC)
+         continue;
+      boundary = count > I->S[j].h && count < I->S[j].h + 1;
+      score = I->S[j].d * fractionality(count);
+      if(bestset < 0 || boundary > bestboundary || (boundary == bestboundary && score > bestscore)){
+         bestset = j;
+         bestscore = score;
+         bestcount = count;
+         bestboundary = boundary;
+      }
+   }
+   if(bestset >= 0){
+#ifdef DEBUG_BRANCH
+      printf("\nBranch on the count of set %d: %lf (h=%d)", bestset, bestcount, I->S[bestset].h);
+#endif
+      SCIP_CALL( SCIPallocBufferArray(scip, &setvars, I->S[bestset].n) );
+      for(i=0;i<I->S[bestset].n;i++)
+         setvars[i] = vars[I->S[bestset].items[i]];
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "count_%d", bestset);
+      SCIP_CALL( branchOnSum(scip, name, setvars, I->S[bestset].n, floor(bestcount)) );
+      SCIPfreeBufferArray(scip, &setvars);
+      branchruledata->nset++;
+      *result = SCIP_BRANCHED;
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * branching rule specific interface methods
+ */
+
+/** creates the forfeit branching rule and includes it in SCIP */
+SCIP_RETCODE SCIPincludeBranchruleForfeit(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_BRANCHRULEDATA* branchruledata;
+   SCIP_BRANCHRULE* branchrule;
+
+   /* create forfeit branching rule data */
+   SCIP_CALL( SCIPallocMemory(scip, &branchruledata) );
+   branchruledata->param = param;
+   branchruledata->nglobal = 0;
+   branchruledata->nviol = 0;
+   branchruledata->nset = 0;
+
+   branchrule = NULL;
+   /* include branching rule */
+   SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY,
+         BRANCHRULE_MAXDEPTH, BRANCHRULE_MAXBOUNDDIST, branchruledata) );
+   assert(branchrule != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetBranchruleCopy(scip, branchrule, branchCopyForfeit) );
+   SCIP_CALL( SCIPsetBranchruleFree(scip, branchrule, branchFreeForfeit) );
+   SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpForfeit) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   branch_forfeit.h
+ * @ingroup BRANCHINGRULES
+ * @brief  branching rule on the forfeit structure
+ *
+ * branches on the total of violations, on the violation variables v_j and on the total of selected items of a forfeit
+ * set. When the LP solution is integral in all of them, the next rule (pscost on x) is used.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_BRANCH_FORFEIT_H__
+#define __SCIP_BRANCH_FORFEIT_H__
+
+
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the forfeit branching rule and includes it in SCIP */
+SCIP_RETCODE SCIPincludeBranchruleForfeit(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
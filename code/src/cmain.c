@@ -27,55 +27,45 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 #include<stdio.h>
-#include<time.h>
 #include<string.h>
 
 #include "scip/scip.h"
-#include "problem.h"
 #include "utils.h"
+#include "run_mochila.h"
+#include "batch_mochila.h"
+#include "server_mochila.h"
 
 int main(int argc, char **argv)
 {
-  SCIP* scip;
-  instanceT* in;
-  clock_t start, end;
-  char outputname[SCIP_MAXSTRLEN];
   parametersT param;
+  phaseTimesT phases;
+  int i;
 
-  // set default+user parameters
-  if(!setParameters(argc, argv, &param))
-     return 0;
-
-  // load instance file
-  if(!loadInstance(argv[1], &in)){
-    printf("\nProblem to read instance file %s\n", argv[1]);
-    return 1;
+  // batch mode: mochila --batch <batch file>
+  if(argc >= 3 && !strcmp(argv[1], "--batch")){
+    SCIP_CALL( batchSolve(argv[0], argv[2]) );
+    BMScheckEmptyMemory();
+    return 0;
   }
-#ifdef DEBUG
-  printInstance(in);
-#endif
-  // create scip and set scip configurations
-  configScip(&scip, &param);
-  // load problem into scip
-  if(!loadProblem(scip,argv[1],in,0,NULL,&param)){
-    printf("\nProblem to load instance problem\n");
-    return 1;
+  // server mode: mochila --server <socket path | -> <parameters-setting>
+  if(argc >= 3 && !strcmp(argv[1], "--server")){
+    defaultParameters(&param);
+    for(i=3;i<argc;i+=2){
+      if(i==argc-1 || setParameterValue(&param, argv[i], argv[i+1])){
+        printf("\nParameter (%s) invalid, uncompleted or out of range.\n", argv[i]);
+        return 0;
+      }
+    }
+    SCIP_CALL( serverRun(argv[0], argv[2], &param) );
+    BMScheckEmptyMemory();
+    return 0;
   }
-  // print problem
-  SCIP_CALL( SCIPwriteOrigProblem(scip, "knapsack.lp", "lp", FALSE) );
-  srand(time(NULL));
-  // solve scip problem
-  start=clock();
-  SCIP_CALL( SCIPsolve(scip) );
-  end = clock();
-  // config output filename
-  configOutputName(outputname, argv[1], argv[0], &param);
-  // print statistics and print resume in output file
-  printStatistic(scip,((double) (end-start))/CLOCKS_PER_SEC, outputname);
-  // write the best solution in a file
-  printSol(scip, outputname);
-  SCIP_CALL( SCIPfree(&scip) ); 
-  freeInstance(in);
+  // set default+user parameters (the first phase of the run)
+  phaseInit(&phases, 0);
+  if(!setParameters(argc, argv, &param))
+     return 0;
+  // load, solve and write the output files
+  SCIP_CALL( runInstance(argv[0], argv[1], &param, 0, &phases) );
   BMScheckEmptyMemory();
   return 0;
 }
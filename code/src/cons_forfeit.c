@@ -0,0 +1,459 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_forfeit.c
+ * @brief  constraint handler for the whole forfeit structure
+ *
+ * Let lo_j be the total of items of S_j fixed in 1 in the current node (the sum of the lower bounds of x, when identical
+ * items were merged in integer variables). Then v_j >= lo_j - h_j, and the sets use at least m_j = max(lb(v_j), lo_j - h_j)
+ * violations of the limit k. If sum_j m_j > k, the node is infeasible. Otherwise, with slack = k - sum_j m_j, each set
+ * can receive at most h_j + m_j + slack items, so ub(v_j) <= m_j + slack, and when lo_j reaches this value the free
+ * items of S_j are fixed in their lower bounds. Generic linear propagation looks at one row at a time and does not see
+ * these implications.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "cons_forfeit.h"
+
+/* fundamental constraint handler properties */
+#define CONSHDLR_NAME          "forfeit"
+#define CONSHDLR_DESC          "forfeit sets with global limit of violations"
+#define CONSHDLR_ENFOPRIORITY  -1000000 /**< priority of the constraint handler for constraint enforcing (after the linear rows) */
+#define CONSHDLR_CHECKPRIORITY -1000000 /**< priority of the constraint handler for checking feasibility */
+#define CONSHDLR_EAGERFREQ          100 /**< frequency for using all instead of only the useful constraints in separation,
+                                         *   propagation and enforcement, -1 for no eager evaluations, 0 for first only */
+#define CONSHDLR_NEEDSCONS         TRUE /**< should the constraint handler be skipped, if no constraints are available? */
+
+/* optional constraint handler properties */
+#define CONSHDLR_PROPFREQ             1 /**< frequency for propagating domains; zero means only preprocessing propagation */
+#define CONSHDLR_DELAYPROP        FALSE /**< should propagation method be delayed, if other propagators found reductions? */
+#define CONSHDLR_PROP_TIMING       SCIP_PROPTIMING_BEFORELP
+
+/*
+ * Data structures
+ */
+
+/** constraint data for forfeit constraints */
+struct SCIP_ConsData
+{
+   instanceT*            I;                  /**< instance */
+   SCIP_VAR**            vars;               /**< x_0..x_{n-1}, v_0..v_{nS-1} */
+   int                   nvars;              /**< total of vars (n + nS) */
+};
+
+/*
+ * Local methods
+ */
+
+/** creates constraint data */
+static
+SCIP_RETCODE consdataCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONSDATA**       consdata,           /**< pointer to store the constraint data */
+   instanceT*            I,                  /**< instance */
+   SCIP_VAR**            vars                /**< item and forfeit variables */
+   )
+{
+   int i;
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, consdata) );
+   (*consdata)->I = I;
+   (*consdata)->nvars = I->n + I->nS;
+   SCIP_CALL( SCIPduplicateBlockMemoryArray(scip, &(*consdata)->vars, vars, (*consdata)->nvars) );
+   for(i=0;i<(*consdata)->nvars;i++){
+      SCIP_CALL( SCIPcaptureVar(scip, (*consdata)->vars[i]) );
+   }
+   return SCIP_OKAY;
+}
+
+/** checks the solution sol (NULL for the LP solution) */
+static
+SCIP_Bool checkCons(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< forfeit constraint */
+   SCIP_SOL*             sol,                /**< solution to check */
+   SCIP_Bool             printreason         /**< should the reason of the violation be printed? */
+   )
+{
+   SCIP_CONSDATA* consdata;
+   instanceT* I;
+   SCIP_Real count, sumv, v;
+   int i, j;
+
+   consdata = SCIPconsGetData(cons);
+   I = consdata->I;
+   sumv = 0.0;
+   for(j=0;j<I->nS;j++){
+      count = 0.0;
+      for(i=0;i<I->S[j].n;i++)
+         count += SCIPgetSolVal(scip, sol, consdata->vars[I->S[j].items[i]]);
+      v = SCIPgetSolVal(scip, sol, consdata->vars[I->n+j]);
+      if(SCIPisFeasGT(scip, count - v, (SCIP_Real) I->S[j].h)){
+         if(printreason)
+            SCIPinfoMessage(scip, NULL, "forfeit set %d: %g items and v_%d = %g > h = %d\n", j, count, j, v, I->S[j].h);
+         return FALSE;
+      }
+      sumv += v;
+   }
+   if(SCIPisFeasGT(scip, sumv, (SCIP_Real) I->k)){
+      if(printreason)
+         SCIPinfoMessage(scip, NULL, "forfeit limit: %g violations > k = %d\n", sumv, I->k);
+      return FALSE;
+   }
+   return TRUE;
+}
+
+/** propagates the counts of the sets and the limit k in the current node */
+static
+SCIP_RETCODE propCons(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< forfeit constraint */
+   SCIP_Bool*            cutoff,             /**< pointer to store whether the node is infeasible */
+   int*                  nchgbds             /**< pointer to count the changed bounds */
+   )
+{
+   SCIP_CONSDATA* consdata;
+   SCIP_VAR* var;
+   SCIP_Bool infeasible, tightened;
+   instanceT* I;
+   int i, j, total, slack, maxitems, *lo, *minv;
+
+   consdata = SCIPconsGetData(cons);
+   I = consdata->I;
+   *cutoff = FALSE;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &lo, I->nS) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &minv, I->nS) );
+   // implied lower bounds of v_j and the minimum of violations of each set
+   total = 0;
+   for(j=0;j<I->nS && !(*cutoff);j++){
+      lo[j] = 0;
+      for(i=0;i<I->S[j].n;i++)
+         lo[j] += (int) SCIPfeasCeil(scip, SCIPvarGetLbLocal(consdata->vars[I->S[j].items[i]]));
+      var = consdata->vars[I->n+j];
+      minv[j] = (int) SCIPfeasCeil(scip, SCIPvarGetLbLocal(var));
+      if(lo[j] - I->S[j].h > minv[j]){
+         minv[j] = lo[j] - I->S[j].h;
+         SCIP_CALL( SCIPtightenVarLb(scip, var, (SCIP_Real) minv[j], FALSE, &infeasible, &tightened) );
+         if(infeasible)
+            *cutoff = TRUE;
+         if(tightened)
+            (*nchgbds)++;
+      }
+      total += minv[j];
+   }
+   if(!(*cutoff) && total > I->k)
+      *cutoff = TRUE;
+   // the remaining budget bounds v_j and the items of each set
+   slack = I->k - total;
+   for(j=0;j<I->nS && !(*cutoff);j++){
+      var = consdata->vars[I->n+j];
+      if(SCIPvarGetUbLocal(var) > minv[j] + slack + 0.5){
+         SCIP_CALL( SCIPtightenVarUb(scip, var, (SCIP_Real) (minv[j] + slack), FALSE, &infeasible, &tightened) );
+         if(infeasible)
+            *cutoff = TRUE;
+         if(tightened)
+            (*nchgbds)++;
+      }
+      maxitems = I->S[j].h + (int) SCIPfeasFloor(scip, SCIPvarGetUbLocal(var));
+      if(lo[j] > maxitems){
+         *cutoff = TRUE;
+      }
+      else if(lo[j] == maxitems){
+         // saturated set: the free items can not enter anymore
+         for(i=0;i<I->S[j].n && !(*cutoff);i++){
+            var = consdata->vars[I->S[j].items[i]];
+            if(SCIPvarGetUbLocal(var) > SCIPvarGetLbLocal(var) + 0.5){
+               SCIP_CALL( SCIPtightenVarUb(scip, var, SCIPvarGetLbLocal(var), FALSE, &infeasible, &tightened) );
+               if(infeasible)
+                  *cutoff = TRUE;
+               if(tightened)
+                  (*nchgbds)++;
+            }
+         }
+      }
+   }
+   SCIPfreeBufferArray(scip, &minv);
+   SCIPfreeBufferArray(scip, &lo);
+   return SCIP_OKAY;
+}
+
+/** enforcement: the linear rows enforce the structure, here infeasible nodes are detected by propagation */
+static
+SCIP_RETCODE enforceConss(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS**           conss,              /**< constraints to process */
+   int                   nconss,             /**< number of constraints */
+   SCIP_SOL*             sol,                /**< solution to enforce (NULL for the LP solution) */
+   SCIP_RESULT*          result              /**< pointer to store the result */
+   )
+{
+   SCIP_Bool cutoff;
+   int c, nchgbds;
+
+   *result = SCIP_FEASIBLE;
+   for(c=0;c<nconss;c++){
+      if(checkCons(scip, conss[c], sol, FALSE))
+         continue;
+      nchgbds = 0;
+      SCIP_CALL( propCons(scip, conss[c], &cutoff, &nchgbds) );
+      if(cutoff){
+         *result = SCIP_CUTOFF;
+         return SCIP_OKAY;
+      }
+      if(nchgbds > 0)
+         *result = SCIP_REDUCEDDOM;
+      else if(*result == SCIP_FEASIBLE)
+         *result = SCIP_INFEASIBLE;
+   }
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of constraint handler
+ */
+
+/** copy method for constraint handler plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_CONSHDLRCOPY(conshdlrCopyForfeit)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+
+   /* call inclusion method of constraint handler */
+   SCIP_CALL( SCIPincludeConshdlrForfeit(scip) );
+   *valid = TRUE;
+
+   return SCIP_OKAY;
+}
+
+/** constraint copying method of constraint handler: the copy shares the instance, with the copies of the variables */
+static
+SCIP_DECL_CONSCOPY(consCopyForfeit)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* sourcedata;
+   SCIP_CONSDATA* consdata;
+   SCIP_CONSHDLR* conshdlr;
+   SCIP_VAR** vars;
+   int i;
+
+   sourcedata = SCIPconsGetData(sourcecons);
+   assert(sourcedata != NULL);
+
+   *valid = TRUE;
+   SCIP_CALL( SCIPallocBufferArray(scip, &vars, sourcedata->nvars) );
+   for(i=0;i<sourcedata->nvars && *valid;i++){
+      SCIP_CALL( SCIPgetVarCopy(sourcescip, scip, sourcedata->vars[i], &vars[i], varmap, consmap, global, valid) );
+   }
+   if(*valid){
+      conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+      assert(conshdlr != NULL);
+      SCIP_CALL( consdataCreate(scip, &consdata, sourcedata->I, vars) );
+      SCIP_CALL( SCIPcreateCons(scip, cons, name != NULL ? name : SCIPconsGetName(sourcecons), conshdlr, consdata,
+            initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode) );
+   }
+   SCIPfreeBufferArray(scip, &vars);
+
+   return SCIP_OKAY;
+}
+
+/** frees specific constraint data */
+static
+SCIP_DECL_CONSDELETE(consDeleteForfeit)
+{  /*lint --e{715}*/
+   int i;
+
+   assert(consdata != NULL);
+   assert(*consdata != NULL);
+
+   for(i=0;i<(*consdata)->nvars;i++){
+      SCIP_CALL( SCIPreleaseVar(scip, &(*consdata)->vars[i]) );
+   }
+   SCIPfreeBlockMemoryArray(scip, &(*consdata)->vars, (*consdata)->nvars);
+   SCIPfreeBlockMemory(scip, consdata);
+
+   return SCIP_OKAY;
+}
+
+/** transforms constraint data into data belonging to the transformed problem */
+static
+SCIP_DECL_CONSTRANS(consTransForfeit)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* sourcedata;
+   SCIP_CONSDATA* targetdata;
+   SCIP_VAR** vars;
+
+   sourcedata = SCIPconsGetData(sourcecons);
+   assert(sourcedata != NULL);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &vars, sourcedata->nvars) );
+   SCIP_CALL( SCIPgetTransformedVars(scip, sourcedata->nvars, sourcedata->vars, vars) );
+   SCIP_CALL( consdataCreate(scip, &targetdata, sourcedata->I, vars) );
+   SCIPfreeBufferArray(scip, &vars);
+
+   /* create target constraint */
+   SCIP_CALL( SCIPcreateCons(scip, targetcons, SCIPconsGetName(sourcecons), conshdlr, targetdata,
+         SCIPconsIsInitial(sourcecons), SCIPconsIsSeparated(sourcecons), SCIPconsIsEnforced(sourcecons),
+         SCIPconsIsChecked(sourcecons), SCIPconsIsPropagated(sourcecons),
+         SCIPconsIsLocal(sourcecons), SCIPconsIsModifiable(sourcecons),
+         SCIPconsIsDynamic(sourcecons), SCIPconsIsRemovable(sourcecons), SCIPconsIsStickingAtNode(sourcecons)) );
+
+   return SCIP_OKAY;
+}
+
+/** constraint enforcing method of constraint handler for LP solutions */
+static
+SCIP_DECL_CONSENFOLP(consEnfolpForfeit)
+{  /*lint --e{715}*/
+   SCIP_CALL( enforceConss(scip, conss, nconss, NULL, result) );
+
+   return SCIP_OKAY;
+}
+
+/** constraint enforcing method of constraint handler for pseudo solutions */
+static
+SCIP_DECL_CONSENFOPS(consEnfopsForfeit)
+{  /*lint --e{715}*/
+   SCIP_CALL( enforceConss(scip, conss, nconss, NULL, result) );
+
+   return SCIP_OKAY;
+}
+
+/** feasibility check method of constraint handler for integral solutions */
+static
+SCIP_DECL_CONSCHECK(consCheckForfeit)
+{  /*lint --e{715}*/
+   int c;
+
+   *result = SCIP_FEASIBLE;
+   for(c=0;c<nconss;c++){
+      if(!checkCons(scip, conss[c], sol, printreason)){
+         *result = SCIP_INFEASIBLE;
+         if(!completely)
+            return SCIP_OKAY;
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** domain propagation method of constraint handler */
+static
+SCIP_DECL_CONSPROP(consPropForfeit)
+{  /*lint --e{715}*/
+   SCIP_Bool cutoff;
+   int c, nchgbds;
+
+   *result = SCIP_DIDNOTFIND;
+   nchgbds = 0;
+   for(c=0;c<nconss;c++){
+      SCIP_CALL( propCons(scip, conss[c], &cutoff, &nchgbds) );
+      if(cutoff){
+         *result = SCIP_CUTOFF;
+         return SCIP_OKAY;
+      }
+   }
+   if(nchgbds > 0)
+      *result = SCIP_REDUCEDDOM;
+
+   return SCIP_OKAY;
+}
+
+/** variable rounding lock method of constraint handler */
+static
+SCIP_DECL_CONSLOCK(consLockForfeit)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+   int i;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   // x_i only has positive coefficients in <= rows: rounding up may violate the constraint
+   for(i=0;i<consdata->I->n;i++){
+#if (defined SCIP_VERSION_MAJOR)
+      SCIP_CALL( SCIPaddVarLocksType(scip, consdata->vars[i], locktype, nlocksneg, nlockspos) );
+#else
+      SCIP_CALL( SCIPaddVarLocks(scip, consdata->vars[i], nlocksneg, nlockspos) );
+#endif
+   }
+   // v_j is in the set row (-1) and in the limit row (+1)
+   for(i=consdata->I->n;i<consdata->nvars;i++){
+#if (defined SCIP_VERSION_MAJOR)
+      SCIP_CALL( SCIPaddVarLocksType(scip, consdata->vars[i], locktype, nlockspos + nlocksneg, nlockspos + nlocksneg) );
+#else
+      SCIP_CALL( SCIPaddVarLocks(scip, consdata->vars[i], nlockspos + nlocksneg, nlockspos + nlocksneg) );
+#endif
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * constraint specific interface methods
+ */
+
+/** creates the handler for forfeit constraints and includes it in SCIP */
+SCIP_RETCODE SCIPincludeConshdlrForfeit(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+
+   conshdlr = NULL;
+   /* include constraint handler */
+   SCIP_CALL( SCIPincludeConshdlrBasic(scip, &conshdlr, CONSHDLR_NAME, CONSHDLR_DESC,
+         CONSHDLR_ENFOPRIORITY, CONSHDLR_CHECKPRIORITY, CONSHDLR_EAGERFREQ, CONSHDLR_NEEDSCONS,
+         consEnfolpForfeit, consEnfopsForfeit, consCheckForfeit, consLockForfeit,
+         NULL) );
+   assert(conshdlr != NULL);
+
+   /* set non-fundamental callbacks via specific setter functions */
+   SCIP_CALL( SCIPsetConshdlrCopy(scip, conshdlr, conshdlrCopyForfeit, consCopyForfeit) );
+   SCIP_CALL( SCIPsetConshdlrDelete(scip, conshdlr, consDeleteForfeit) );
+   SCIP_CALL( SCIPsetConshdlrTrans(scip, conshdlr, consTransForfeit) );
+   SCIP_CALL( SCIPsetConshdlrProp(scip, conshdlr, consPropForfeit, CONSHDLR_PROPFREQ, CONSHDLR_DELAYPROP,
+         CONSHDLR_PROP_TIMING) );
+
+   return SCIP_OKAY;
+}
+
+/** creates a forfeit constraint */
+SCIP_RETCODE SCIPcreateConsForfeit(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint */
+   const char*           name,               /**< name of constraint */
+   instanceT*            I,                  /**< instance */
+   SCIP_VAR**            vars                /**< item and forfeit variables */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+   SCIP_CONSDATA* consdata;
+
+   conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+   if(conshdlr == NULL){
+      SCIPerrorMessage("forfeit constraint handler not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+   SCIP_CALL( consdataCreate(scip, &consdata, I, vars) );
+
+   /* create constraint: not initial and not separated, the LP uses the linear rows */
+   SCIP_CALL( SCIPcreateCons(scip, cons, name, conshdlr, consdata, FALSE, FALSE, TRUE, TRUE, TRUE,
+         FALSE, FALSE, FALSE, FALSE, FALSE) );
+
+   return SCIP_OKAY;
+}
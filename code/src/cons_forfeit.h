@@ -0,0 +1,56 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_forfeit.h
+ * @ingroup CONSHDLRS
+ * @brief  constraint handler for the whole forfeit structure: sum_{i in S_j} x_i - v_j <= h_j and sum_j v_j <= k
+ *
+ * The linear rows of the model are kept (they give the LP relaxation). This constraint propagates the counts of the
+ * sets, the implied lower bounds of v_j and the global limit k together: when the limit is exhausted, the free items of
+ * the saturated sets are fixed in 0.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_CONS_FORFEIT_H__
+#define __SCIP_CONS_FORFEIT_H__
+
+
+#include "scip/scip.h"
+#include "problem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates a forfeit constraint. vars has the order of SCIPprobdataGetVars(): x_0..x_{n-1}, v_0..v_{nS-1} */
+SCIP_RETCODE SCIPcreateConsForfeit(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint */
+   const char*           name,               /**< name of constraint */
+   instanceT*            I,                  /**< instance */
+   SCIP_VAR**            vars                /**< item and forfeit variables */
+   );
+
+/** creates the handler for forfeit constraints and includes it in SCIP */
+SCIP_RETCODE SCIPincludeConshdlrForfeit(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,252 @@
+/**@file   core_mochila.c
+ * @brief  core mode: solves only a window of items around the break item, the other items are fixed
+ *
+ * Let z_LP, x* and rc be the value, the solution and the reduced costs of the LP relaxation of the whole instance.
+ * Forcing x_i = t gives the bound z_LP - max(0, rc_i*ub_i) + rc_i*t. A fixing of the core is proven when this bound,
+ * with t the opposite value, is below z* + 1 (the objective is integer), where z* is the optimum of the core. The reduced
+ * costs are read with SCIPgetVarRedcost by an eventhdlr of the LP scip, because they are only available while solving.
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<math.h>
+#include "core_mochila.h"
+#include "probdata_mochila.h"
+#include "run_mochila.h"
+#include "utils.h"
+
+//#define DEBUG_CORE 1
+
+#define EVENTHDLR_NAME         "corelp"
+#define EVENTHDLR_DESC         "reads the reduced costs of the LP relaxation of the core mode"
+
+/** data of the eventhdlr that reads the reduced costs while the LP scip is solving */
+struct SCIP_EventhdlrData
+{
+   instanceT*            I;
+   double*               rc;                 /**< reduced costs of x (sense of the original problem) */
+   int                   read;               /**< 1 if rc has the reduced costs of an optimal LP */
+};
+
+typedef struct{
+   int item;
+   double e; /**< efficiency of the item */
+} coreItemT;
+
+static int compareEfficiency(const void* a, const void* b)
+{
+   double ea = ((coreItemT*) a)->e, eb = ((coreItemT*) b)->e;
+
+   return ea < eb ? 1 : (ea > eb ? -1 : 0);
+}
+
+/** solving process initialization method of the eventhdlr */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolCorelp)
+{  /*lint --e{715}*/
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, NULL) );
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of the eventhdlr */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolCorelp)
+{  /*lint --e{715}*/
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, -1) );
+   return SCIP_OKAY;
+}
+
+/** execution method of the eventhdlr: SCIPgetVarRedcost is only available while solving */
+static
+SCIP_DECL_EVENTEXEC(eventExecCorelp)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_VAR** vars;
+   int i;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   if(SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)
+      return SCIP_OKAY;
+   vars = SCIPprobdataGetVars(SCIPgetProbData(scip));
+   // the reduced costs are of the transformed (minimization) problem
+   for(i=0;i<eventhdlrdata->I->n;i++)
+      eventhdlrdata->rc[i] = (double) SCIPgetObjsense(scip) * SCIPgetVarRedcost(scip, vars[i]);
+   eventhdlrdata->read = 1;
+   return SCIP_OKAY;
+}
+
+/** solves the LP relaxation of the whole instance: value and reduced costs of x */
+static SCIP_RETCODE solveLP(instanceT* I, parametersT* param, double* zlp, double* rc)
+{
+   SCIP* lpscip;
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA eventhdlrdata;
+   parametersT lpparam;
+   int i;
+
+   // pure LP without presolving: the columns of x are in the LP of the root
+   configSubscipParam(&lpparam, param->time_limit);
+   configScip(&lpscip, &lpparam);
+   SCIP_CALL( SCIPsetIntParam(lpscip, "display/verblevel", 0) );
+   eventhdlrdata.I = I;
+   eventhdlrdata.rc = rc;
+   eventhdlrdata.read = 0;
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(lpscip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecCorelp, &eventhdlrdata) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(lpscip, eventhdlr, eventInitsolCorelp) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(lpscip, eventhdlr, eventExitsolCorelp) );
+   if(!loadProblem(lpscip, "core_lp", I, 1, NULL, &lpparam)){
+      printf("\nProblem to load the LP relaxation\n");
+      SCIP_CALL( SCIPfree(&lpscip) );
+      return SCIP_ERROR;
+   }
+   SCIP_CALL( SCIPsolve(lpscip) );
+   *zlp = SCIPgetPrimalbound(lpscip);
+   // without an optimal LP no fixing can be proven: all reduced costs are 0, so every fixing fails the test
+   if(!eventhdlrdata.read){
+      for(i=0;i<I->n;i++)
+         rc[i] = 0.0;
+   }
+   SCIP_CALL( SCIPfree(&lpscip) );
+   return SCIP_OKAY;
+}
+
+SCIP_RETCODE coreSolve(SCIP** pscip, char* probname, instanceT* I, parametersT* param, int quiet)
+{
+   SCIP* scip;
+   SCIP_SOL* sol;
+   SCIP_VAR** vars;
+   SCIP_Bool stored;
+   SCIP_RETCODE retcode;
+   coreItemT* order;
+   double start, zlp, zcore, bound, remaining, *rc;
+   int i, j, p, b, lo, hi, size, weight, viol, add, iter, nfree, nfailed, done, hassol, *fixed, *incore, *x, *count;
+
+   // the time limit of SCIP is in wall clock time
+   start = wallTime();
+   rc = (double*) malloc(sizeof(double)*I->n);
+   retcode = solveLP(I, param, &zlp, rc);
+   if(retcode != SCIP_OKAY){
+      free(rc);
+      return retcode;
+   }
+
+   // efficiency: value minus the expected forfeit cost (fraction of the items of the set over h) by weight
+   order = (coreItemT*) malloc(sizeof(coreItemT)*I->n);
+   for(i=0;i<I->n;i++){
+      order[i].item = i;
+      order[i].e = I->item[i].value;
+      for(j=0;j<I->item[i].nsets;j++){
+         p = I->item[i].set[j];
+         if(I->S[p].n > I->S[p].h)
+            order[i].e -= I->S[p].d*(double) (I->S[p].n - I->S[p].h)/I->S[p].n;
+      }
+      order[i].e /= I->item[i].weight > 0 ? I->item[i].weight : 1;
+   }
+   qsort(order, I->n, sizeof(coreItemT), compareEfficiency);
+   // break item: the first one that does not fit in the greedy solution (capacity and limit k of the violations), so
+   // the items fixed in 1 before the core are always feasible
+   weight = viol = 0;
+   count = (int*) calloc(I->nS+1, sizeof(int));
+   for(b=0;b<I->n;b++){
+      i = order[b].item;
+      if(weight + I->item[i].weight*I->item[i].mult > I->C)
+         break;
+      add = 0;
+      for(j=0;j<I->item[i].nsets;j++){
+         p = I->item[i].set[j];
+         add += MAX(0, count[p] + I->item[i].mult - I->S[p].h) - MAX(0, count[p] - I->S[p].h);
+      }
+      if(viol + add > I->k)
+         break;
+      weight += I->item[i].weight*I->item[i].mult;
+      viol += add;
+      for(j=0;j<I->item[i].nsets;j++)
+         count[I->item[i].set[j]] += I->item[i].mult;
+   }
+   free(count);
+
+   fixed = (int*) malloc(sizeof(int)*I->n);
+   incore = (int*) calloc(I->n, sizeof(int));
+   x = (int*) calloc(I->n, sizeof(int));
+   size = param->core_size;
+   scip = NULL;
+   done = 0;
+   hassol = 0;
+   for(iter=1;!done;iter++){
+      lo = b - size/2 < 0 ? 0 : b - size/2;
+      hi = lo + size > I->n ? I->n : lo + size;
+      nfree = 0;
+      for(p=0;p<I->n;p++){
+         i = order[p].item;
+         if(incore[i] || (p >= lo && p < hi)){
+            incore[i] = 1;
+            fixed[i] = 0;
+            nfree++;
+         }
+         else
+            fixed[i] = p < lo ? 1 : -1;
+      }
+      remaining = param->time_limit - (wallTime() - start);
+      if(scip != NULL){
+         SCIP_CALL( SCIPfree(&scip) );
+      }
+      configScip(&scip, param);
+      if(quiet)
+         SCIPsetMessagehdlrQuiet(scip, TRUE);
+      if(remaining > 0){
+         SCIP_CALL( SCIPsetRealParam(scip, "limits/time", remaining) );
+      }
+      if(!loadProblem(scip, probname, I, 0, nfree < I->n ? fixed : NULL, param)){
+         printf("\nProblem to load the core problem\n");
+         SCIP_CALL( SCIPfree(&scip) );
+         free(x);
+         free(incore);
+         free(fixed);
+         free(order);
+         free(rc);
+         return SCIP_ERROR;
+      }
+      // the best solution of the previous core is feasible for the larger core
+      if(hassol){
+         SCIP_CALL( createSolFromItems(scip, NULL, x, &sol) );
+         SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      }
+      SCIP_CALL( SCIPsolve(scip) );
+      zcore = SCIPgetPrimalbound(scip);
+      if(SCIPgetBestSol(scip) != NULL){
+         hassol = 1;
+         vars = SCIPprobdataGetVars(SCIPgetProbData(scip));
+         for(i=0;i<I->n;i++)
+            x[i] = (int) floor(SCIPgetSolVal(scip, SCIPgetBestSol(scip), vars[i]) + 0.5);
+      }
+      // reduced cost test of the fixings
+      nfailed = 0;
+      if(SCIPgetStatus(scip) == SCIP_STATUS_OPTIMAL){
+         for(i=0;i<I->n;i++){
+            if(!fixed[i] || incore[i])
+               continue;
+            // the merged items of the symmetry are integer in [0,mult]: the item fixed in 0 is flipped to mult
+            bound = zlp - (rc[i] > 0.0 ? rc[i]*I->item[i].mult : 0.0) + rc[i]*(fixed[i] == 1 ? 0.0 : I->item[i].mult);
+            if(bound >= zcore + 1.0 - EPSILON){
+               incore[i] = 1; // the item enters in the next core
+               nfailed++;
+            }
+         }
+      }
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "\nCore iteration %d: %d free items, z=%lf (LP=%lf), %d fixings not proven, status=%d\n", iter, nfree, zcore, zlp, nfailed, SCIPgetStatus(scip));
+      if(nfree == I->n || (SCIPgetStatus(scip) == SCIP_STATUS_OPTIMAL && nfailed == 0))
+         done = 1;
+      else if(wallTime() - start >= param->time_limit)
+         break;
+      size *= 2;
+   }
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "\nCore: %s with %d free items of %d\n", done ? "finished" : "stopped by the time limit", nfree, I->n);
+   free(x);
+   free(incore);
+   free(fixed);
+   free(order);
+   free(rc);
+   *pscip = scip;
+   return SCIP_OKAY;
+}
@@ -0,0 +1,19 @@
+/**@file   core_mochila.h
+ * @brief  core mode: solves only a window of items around the break item, the other items are fixed
+ *
+ * The items are sorted by efficiency (value minus the expected forfeit cost, divided by the weight). The items before
+ * the core window are fixed in 1 and the items after it are fixed in 0 (the items fixed in 1 are a prefix of the greedy
+ * solution, which respects the capacity and the limit k). After solving the core with SCIP, the
+ * fixings are checked with the reduced costs of the LP relaxation of the whole instance; if some fixing can not be
+ * proven, the window is doubled (and the failed items are freed) and the core is solved again.
+ **/
+#ifndef __CORE_MOCHILA__
+#define __CORE_MOCHILA__
+#include "scip/scip.h"
+#include "problem.h"
+#include "parameters_mochila.h"
+
+// solves the instance I by the core mode. *pscip returns the SCIP of the last core solved (to print statistics).
+// With quiet=1 (batch mode and library) the SCIPs of the cores and the messages of the core mode are silent
+SCIP_RETCODE coreSolve(SCIP** pscip, char* probname, instanceT* I, parametersT* param, int quiet);
+#endif
@@ -0,0 +1,206 @@
+/**@file   dp_mochila.c
+ * @brief  exact dynamic programming for small knapsack with forfeit sets subproblems
+ *
+ * Let F be the free items and A the forfeit sets that contain some item of F. A state of the DP is a pair (p,c), where
+ * c is the used capacity and p is a count profile: the number of items of F selected from each set of A, encoded in
+ * mixed radix (the digit of set j goes from 0 to the number of free items in j). Items are processed one at a time and
+ * each row dp[p][0..C] keeps the best value (without forfeit costs) of the selections with profile p. Forfeit costs and
+ * the limit k only depend on the final profile, so they are charged at the end. The decisions are saved in one bitset
+ * per item, which is used to recover the optimal solution.
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<limits.h>
+#include "dp_mochila.h"
+
+#define DP_NONE -1 /**< unreachable state (values are non negative) */
+
+int dpSolve(instanceT* I, int* fixed, int maxcells, int* x, int* z)
+{
+   int i, j, a, t, p, c, w, v, s, q, cap, nF, nA, nP, base, baseViol, viol, cnt, pen, best, bestP, bestC, status;
+   int *F, *count, *nfree, *aset, *radix, *stride, *istride, *dp, *row, *nrow;
+   unsigned char *take, *bits;
+   size_t cell, rowbits;
+   double cells;
+
+   cap = I->C;
+   base = 0;
+   count = (int*) calloc(I->nS, sizeof(int)); // total of items fixed in 1.0 in each forfeit set
+   for(i=0;i<I->n;i++){
+      x[i] = 0;
+      if(fixed[i]==1){
+         x[i] = 1;
+         cap -= I->item[i].weight;
+         base += I->item[i].value;
+         for(j=0;j<I->item[i].nsets;j++)
+            count[I->item[i].set[j]]++;
+      }
+   }
+   if(cap < 0){
+      free(count);
+      return -1;
+   }
+   // free items: not fixed, fit in the residual capacity and have positive value
+   F = (int*) malloc(sizeof(int)*I->n);
+   nfree = (int*) calloc(I->nS, sizeof(int));
+   nF = 0;
+   for(i=0;i<I->n;i++){
+      if(!fixed[i] && I->item[i].weight <= cap && I->item[i].value > 0){
+         F[nF++] = i;
+         for(j=0;j<I->item[i].nsets;j++)
+            nfree[I->item[i].set[j]]++;
+      }
+   }
+   // active sets get one digit in the profile; the others only pay for the fixed items
+   aset = (int*) malloc(sizeof(int)*(I->nS+1));
+   radix = (int*) malloc(sizeof(int)*(I->nS+1));
+   stride = (int*) malloc(sizeof(int)*(I->nS+1));
+   nA = 0;
+   nP = 1;
+   baseViol = 0;
+   cells = cap + 1.0;
+   for(j=0;j<I->nS && cells <= maxcells;j++){
+      if(nfree[j] > 0){
+         aset[nA] = j;
+         radix[nA] = nfree[j] + 1;
+         stride[nA] = nP;
+         nP *= radix[nA];
+         cells *= radix[nA];
+         nfree[j] = nA++; // from now on, nfree[j] is the digit of set j
+      }
+      else{
+         nfree[j] = -1;
+         if(count[j] > I->S[j].h){
+            base -= I->S[j].d*(count[j] - I->S[j].h);
+            baseViol += count[j] - I->S[j].h;
+         }
+      }
+   }
+   if(cells > maxcells){
+      free(stride); free(radix); free(aset); free(nfree); free(F); free(count);
+      return 0;
+   }
+   // profile increment of each free item
+   istride = (int*) malloc(sizeof(int)*(nF+1));
+   for(t=0;t<nF;t++){
+      istride[t] = 0;
+      i = F[t];
+      for(j=0;j<I->item[i].nsets;j++)
+         istride[t] += stride[nfree[I->item[i].set[j]]];
+   }
+   dp = (int*) malloc(sizeof(int)*nP*(cap+1));
+   for(cell=0;cell<(size_t)nP*(cap+1);cell++)
+      dp[cell] = DP_NONE;
+   dp[0] = 0;
+   rowbits = (size_t)nP*(cap+1);
+   take = (unsigned char*) calloc(nF*((rowbits+7)/8)+1, sizeof(unsigned char));
+
+   for(t=0;t<nF;t++){
+      i = F[t];
+      w = I->item[i].weight;
+      v = I->item[i].value;
+      s = istride[t];
+      bits = take + t*((rowbits+7)/8);
+      // profiles and capacities in decreasing order, so each item is used at most once
+      for(p=nP-1-s;p>=0;p--){
+         row = dp + (size_t)p*(cap+1);
+         nrow = dp + (size_t)(p+s)*(cap+1);
+         for(c=cap-w;c>=0;c--){
+            if(row[c] != DP_NONE && row[c] + v > nrow[c+w]){
+               nrow[c+w] = row[c] + v;
+               cell = (size_t)(p+s)*(cap+1) + c + w;
+               bits[cell>>3] |= (unsigned char)(1 << (cell&7));
+            }
+         }
+      }
+   }
+   // charge the forfeit costs of each final profile
+   best = INT_MIN;
+   bestP = bestC = 0;
+   for(p=0;p<nP;p++){
+      q = p;
+      pen = 0;
+      viol = baseViol;
+      for(a=0;a<nA;a++){
+         j = aset[a];
+         cnt = count[j] + q % radix[a];
+         q /= radix[a];
+         if(cnt > I->S[j].h){
+            pen += I->S[j].d*(cnt - I->S[j].h);
+            viol += cnt - I->S[j].h;
+         }
+      }
+      if(viol > I->k)
+         continue;
+      row = dp + (size_t)p*(cap+1);
+      for(c=0;c<=cap;c++){
+         if(row[c] != DP_NONE && row[c] - pen > best){
+            best = row[c] - pen;
+            bestP = p;
+            bestC = c;
+         }
+      }
+   }
+   status = -1;
+   if(best != INT_MIN){
+      // recover the selected items
+      p = bestP;
+      c = bestC;
+      for(t=nF-1;t>=0;t--){
+         cell = (size_t)p*(cap+1) + c;
+         bits = take + t*((rowbits+7)/8);
+         if(bits[cell>>3] & (1 << (cell&7))){
+            x[F[t]] = 1;
+            p -= istride[t];
+            c -= I->item[F[t]].weight;
+         }
+      }
+      *z = base + best;
+      status = 1;
+   }
+   free(take); free(dp); free(istride);
+   free(stride); free(radix); free(aset); free(nfree); free(F); free(count);
+   return status;
+}
+
+int dpBound(instanceT* I, int* fixed)
+{
+   int i, j, c, cap, base, w, v, *count, *row;
+
+   cap = I->C;
+   base = 0;
+   count = (int*) calloc(I->nS, sizeof(int));
+   for(i=0;i<I->n;i++){
+      if(fixed[i]==1){
+         cap -= I->item[i].weight;
+         base += I->item[i].value;
+         for(j=0;j<I->item[i].nsets;j++)
+            count[I->item[i].set[j]]++;
+      }
+   }
+   if(cap < 0){
+      free(count);
+      return INT_MIN;
+   }
+   // forfeit costs of the fixed items can only grow when free items are added
+   for(j=0;j<I->nS;j++){
+      if(count[j] > I->S[j].h)
+         base -= I->S[j].d*(count[j] - I->S[j].h);
+   }
+   // 0-1 knapsack over the free items: row[c] = best value using capacity at most c
+   row = (int*) calloc(cap+1, sizeof(int));
+   for(i=0;i<I->n;i++){
+      w = I->item[i].weight;
+      v = I->item[i].value;
+      if(fixed[i] || w > cap || v <= 0)
+         continue;
+      for(c=cap;c>=w;c--){
+         if(row[c-w] + v > row[c])
+            row[c] = row[c-w] + v;
+      }
+   }
+   base += row[cap];
+   free(row);
+   free(count);
+   return base;
+}
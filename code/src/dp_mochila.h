@@ -0,0 +1,32 @@
+/**@file   dp_mochila.h
+ * @brief  exact dynamic programming for small knapsack with forfeit sets subproblems
+ *
+ * The DP works over the residual capacity and over the counts of the forfeit sets touched by the free items.
+ * It is used as an exact subsolver (instead of a sub-SCIP) and as a cheap upper bound for neighborhoods.
+ **/
+#ifndef __DP_MOCHILA__
+#define __DP_MOCHILA__
+#include "problem.h"
+
+#define DP_MAXCELLS (1<<20) /**< maximum of (count profiles x capacity) cells allowed in dpSolve() */
+
+/**
+ * @brief solves exactly the instance restricted by fixed (fixed[i]=1 in, fixed[i]=-1 out, fixed[i]=0 free).
+ *
+ * @param I instance
+ * @param fixed vector of fixed items
+ * @param maxcells limit on the size of the DP table
+ * @param x output: x[i]=1 if item i is in the optimal solution, 0 otherwise
+ * @param z output: objective value of the optimal solution
+ * @return int 1 if solved, 0 if the DP table would exceed maxcells (nothing done), -1 if infeasible.
+ */
+int dpSolve(instanceT* I, int* fixed, int maxcells, int* x, int* z);
+
+/**
+ * @brief upper bound for the instance restricted by fixed: value of the fixed part (with its forfeit costs)
+ * plus the best knapsack of the free items ignoring forfeit costs and limits.
+ *
+ * @return int the bound (INT_MIN if the fixed part exceeds the capacity)
+ */
+int dpBound(instanceT* I, int* fixed);
+#endif
@@ -0,0 +1,255 @@
+/**@file   event_elitepool.c
+ * @brief  eventhdlr that keeps a pool of elite (good and diverse) solutions
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "probdata_mochila.h"
+#include "event_elitepool.h"
+
+#define EVENTHDLR_NAME         "elitepool"
+#define EVENTHDLR_DESC         "keeps the best and most diverse solutions found"
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   elitePoolT*           pool;               /**< pool of elite solutions */
+   const parametersT*    param;              /**< pointer to the config parameters */
+};
+
+/*
+ * Local methods
+ */
+
+void elitePoolCreate(elitePoolT** pool, int size, int n, int mindist)
+{
+   int s;
+
+   *pool = (elitePoolT*) malloc(sizeof(elitePoolT));
+   (*pool)->size = size;
+   (*pool)->nsols = 0;
+   (*pool)->n = n;
+   (*pool)->mindist = mindist;
+   (*pool)->version = 0;
+   (*pool)->value = (int*) malloc(sizeof(int)*size);
+   (*pool)->x = (int**) malloc(sizeof(int*)*size);
+   for(s=0;s<size;s++)
+      (*pool)->x[s] = (int*) malloc(sizeof(int)*n);
+}
+void elitePoolFree(elitePoolT** pool)
+{
+   int s;
+
+   if(*pool){
+      for(s=0;s<(*pool)->size;s++)
+         free((*pool)->x[s]);
+      free((*pool)->x);
+      free((*pool)->value);
+      free(*pool);
+      *pool = NULL;
+   }
+}
+int elitePoolDistance(elitePoolT* pool, int* x1, int* x2)
+{
+   int i, dist;
+
+   dist = 0;
+   for(i=0;i<pool->n;i++){
+      if(x1[i] != x2[i])
+         dist++;
+   }
+   return dist;
+}
+int elitePoolAdd(elitePoolT* pool, int* x, int value)
+{
+   int s, dist, mindist, best, worst, target, targetdist;
+
+   if(pool->size <= 0)
+      return 0;
+   mindist = pool->n + 1;
+   best = worst = -1;
+   for(s=0;s<pool->nsols;s++){
+      dist = elitePoolDistance(pool, x, pool->x[s]);
+      if(dist < mindist)
+         mindist = dist;
+      if(best < 0 || pool->value[s] > pool->value[best])
+         best = s;
+      if(worst < 0 || pool->value[s] < pool->value[worst])
+         worst = s;
+   }
+   // discard copies, and solutions too close to the pool unless they are the best ones
+   if(mindist == 0)
+      return 0;
+   if(mindist < pool->mindist && (best < 0 || value <= pool->value[best]))
+      return 0;
+   if(pool->nsols < pool->size){
+      target = pool->nsols++;
+   }
+   else{
+      if(value <= pool->value[worst])
+         return 0;
+      // replace the most similar solution among the worse ones
+      target = -1;
+      targetdist = pool->n + 1;
+      for(s=0;s<pool->nsols;s++){
+         if(pool->value[s] < value){
+            dist = elitePoolDistance(pool, x, pool->x[s]);
+            if(dist < targetdist){
+               targetdist = dist;
+               target = s;
+            }
+         }
+      }
+      assert(target >= 0);
+   }
+   memcpy(pool->x[target], x, sizeof(int)*pool->n);
+   pool->value[target] = value;
+   pool->version++;
+   return 1;
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** copy method for event handler plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_EVENTCOPY(eventCopyElitePool)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   /* call inclusion method of event handler */
+   SCIP_CALL( SCIPincludeEventhdlrElitePool(scip, SCIPeventhdlrGetData(eventhdlr)->param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeElitePool)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   elitePoolFree(&eventhdlrdata->pool);
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolElitePool)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   instanceT* I;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   I = SCIPprobdataGetInstance(SCIPgetProbData(scip));
+   elitePoolFree(&eventhdlrdata->pool);
+   elitePoolCreate(&eventhdlrdata->pool, eventhdlrdata->param->pool_size, I->n, eventhdlrdata->param->pool_mindist);
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_SOLFOUND, eventhdlr, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolElitePool)
+{  /*lint --e{715}*/
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_SOLFOUND, eventhdlr, NULL, -1) );
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static
+SCIP_DECL_EVENTEXEC(eventExecElitePool)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_SOL* sol;
+   instanceT* I;
+   int i, *x;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   assert(eventhdlrdata->pool != NULL);
+
+   sol = SCIPeventGetSol(event);
+   assert(sol != NULL);
+
+   probdata = SCIPgetProbData(scip);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+
+   x = (int*) malloc(sizeof(int)*I->n);
+   for(i=0;i<I->n;i++)
+      x[i] = SCIPgetSolVal(scip, sol, vars[i]) > 0.5 ? 1 : 0;
+   (void) elitePoolAdd(eventhdlrdata->pool, x, (int) floor(SCIPgetSolOrigObj(scip, sol) + 0.5));
+   free(x);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** returns the elite pool of scip (NULL if the eventhdlr was not included) */
+elitePoolT* SCIPgetElitePool(
+   SCIP*                 scip                 /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return NULL;
+   return SCIPeventhdlrGetData(eventhdlr)->pool;
+}
+
+/** creates the elite pool eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrElitePool(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+   eventhdlrdata->pool = NULL;
+   eventhdlrdata->param = param;
+
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecElitePool, eventhdlrdata) );
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrCopy(scip, eventhdlr, eventCopyElitePool) );
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeElitePool) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolElitePool) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolElitePool) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,55 @@
+/**@file   event_elitepool.h
+ * @brief  eventhdlr that keeps a pool of elite (good and diverse) solutions
+ *
+ * Every solution found by SCIP (by any heuristic or by the LP) is offered to the pool. The pool keeps at most
+ * --pool_size solutions, and a new solution only enters if it is far (in Hamming distance over the x variables) from
+ * the solutions already in the pool, or if it is the best one.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_ELITEPOOL_H__
+#define __SCIP_EVENT_ELITEPOOL_H__
+
+
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** pool of elite solutions */
+typedef struct{
+   int size;          /**< maximum of solutions in the pool */
+   int nsols;         /**< total of solutions in the pool */
+   int n;             /**< total of items */
+   int mindist;       /**< minimum Hamming distance to the other solutions to enter the pool */
+   int** x;           /**< x[s][i]=1 if item i is in the solution s */
+   int* value;        /**< objective value of each solution */
+   int version;       /**< incremented each time the pool changes */
+} elitePoolT;
+
+void elitePoolCreate(elitePoolT** pool, int size, int n, int mindist);
+void elitePoolFree(elitePoolT** pool);
+// Hamming distance between two solutions
+int elitePoolDistance(elitePoolT* pool, int* x1, int* x2);
+// try to insert a solution in the pool. Returns 1 if the solution was inserted
+int elitePoolAdd(elitePoolT* pool, int* x, int value);
+
+/** returns the elite pool of scip (NULL if the eventhdlr was not included) */
+elitePoolT* SCIPgetElitePool(
+   SCIP*                 scip                 /**< SCIP data structure */
+   );
+
+/** creates the elite pool eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrElitePool(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
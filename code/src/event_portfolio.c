@@ -0,0 +1,238 @@
+/**@file   event_portfolio.c
+ * @brief  eventhdlr that shares the incumbent value among the solvers of the portfolio mode
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "event_portfolio.h"
+#include "utils.h"
+
+#define EVENTHDLR_NAME         "portfolio"
+#define EVENTHDLR_DESC         "shares the best objective value among the solvers of the portfolio"
+
+#define EVENTTYPE_PORTFOLIO    (SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED)
+
+//#define DEBUG_PORTFOLIO 1
+
+/*
+ * Data structures
+ */
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   portfolioSlotT*       slot;               /**< slot shared by the solvers */
+   int*                  x;                  /**< items of the solutions (pushed or imported) */
+   int                   n;
+   long long             imported;           /**< value of the last solution imported from the slot */
+   int                   hasimported;        /**< 1 if some solution was imported */
+   SCIP_Longint          nimported;          /**< total of solutions imported from the slot */
+};
+
+/*
+ * Local methods
+ */
+
+void portfolioSlotInit(portfolioSlotT* slot, int n)
+{
+   slot->best = LLONG_MIN;
+   slot->stop = 0;
+   slot->n = n;
+   slot->x = (int*) calloc(n+1, sizeof(int));
+   pthread_mutex_init(&slot->lock, NULL);
+}
+void portfolioSlotFree(portfolioSlotT* slot)
+{
+   pthread_mutex_destroy(&slot->lock);
+   free(slot->x);
+   slot->x = NULL;
+}
+int portfolioSlotPush(portfolioSlotT* slot, long long value, const int* x)
+{
+   int better;
+
+   // fast check without the lock: most solutions of a solver do not beat the portfolio
+   if(value <= __atomic_load_n(&slot->best, __ATOMIC_ACQUIRE))
+      return 0;
+   pthread_mutex_lock(&slot->lock);
+   better = value > slot->best;
+   if(better){
+      memcpy(slot->x, x, sizeof(int)*slot->n);
+      __atomic_store_n(&slot->best, value, __ATOMIC_RELEASE);
+   }
+   pthread_mutex_unlock(&slot->lock);
+   return better;
+}
+int portfolioSlotGet(portfolioSlotT* slot, long long* value)
+{
+   *value = __atomic_load_n(&slot->best, __ATOMIC_ACQUIRE);
+   return *value != LLONG_MIN;
+}
+int portfolioSlotGetSol(portfolioSlotT* slot, long long* value, int* x)
+{
+   pthread_mutex_lock(&slot->lock);
+   *value = slot->best;
+   if(*value != LLONG_MIN)
+      memcpy(x, slot->x, sizeof(int)*slot->n);
+   pthread_mutex_unlock(&slot->lock);
+   return *value != LLONG_MIN;
+}
+void portfolioSlotStop(portfolioSlotT* slot)
+{
+   __atomic_store_n(&slot->stop, 1, __ATOMIC_RELEASE);
+}
+int portfolioSlotStopped(portfolioSlotT* slot)
+{
+   return __atomic_load_n(&slot->stop, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreePortfolio)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPfreeMemoryArrayNull(scip, &eventhdlrdata->x);
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolPortfolio)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+   eventhdlrdata->hasimported = 0;
+   if(eventhdlrdata->x == NULL){
+      eventhdlrdata->n = eventhdlrdata->slot->n;
+      SCIP_CALL( SCIPallocMemoryArray(scip, &eventhdlrdata->x, eventhdlrdata->n+1) );
+   }
+
+   SCIP_CALL( SCIPcatchEvent(scip, EVENTTYPE_PORTFOLIO, eventhdlr, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolPortfolio)
+{  /*lint --e{715}*/
+
+   SCIP_CALL( SCIPdropEvent(scip, EVENTTYPE_PORTFOLIO, eventhdlr, NULL, -1) );
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static
+SCIP_DECL_EVENTEXEC(eventExecPortfolio)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_VAR** vars;
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   long long best, slotbest;
+   int i;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if(SCIPeventGetType(event) == SCIP_EVENTTYPE_BESTSOLFOUND){
+      // own solution: offered to the other solvers (the imported ones are not better than the slot)
+      sol = SCIPeventGetSol(event);
+      best = (long long) floor(SCIPgetSolOrigObj(scip, sol) + 0.5);
+      if(!portfolioSlotGet(eventhdlrdata->slot, &slotbest) || best > slotbest){
+         vars = SCIPprobdataGetVars(SCIPgetProbData(scip));
+         for(i=0;i<eventhdlrdata->n;i++)
+            eventhdlrdata->x[i] = (int) floor(SCIPgetSolVal(scip, sol, vars[i]) + 0.5);
+         (void) portfolioSlotPush(eventhdlrdata->slot, best, eventhdlrdata->x);
+      }
+      return SCIP_OKAY;
+   }
+   if(portfolioSlotStopped(eventhdlrdata->slot)){
+      SCIP_CALL( SCIPinterruptSolve(scip) );
+      return SCIP_OKAY;
+   }
+   // a better solution of other solver: it is added to this SCIP (maximization)
+   if(portfolioSlotGet(eventhdlrdata->slot, &best) && (!eventhdlrdata->hasimported || best > eventhdlrdata->imported)
+      && SCIPisGT(scip, (SCIP_Real) best, SCIPgetPrimalbound(scip))
+      && portfolioSlotGetSol(eventhdlrdata->slot, &best, eventhdlrdata->x)){
+      eventhdlrdata->imported = best;
+      eventhdlrdata->hasimported = 1;
+      SCIP_CALL( createSolFromItems(scip, NULL, eventhdlrdata->x, &sol) );
+      SCIP_CALL( SCIPtrySolMine(scip, sol, FALSE, TRUE, FALSE, TRUE, &stored) );
+      SCIP_CALL( SCIPfreeSol(scip, &sol) );
+      if(stored)
+         eventhdlrdata->nimported++;
+#ifdef DEBUG_PORTFOLIO
+      printf("\nPortfolio: solution %lld imported (%s)", best, stored ? "stored" : "rejected");
+#endif
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** returns the total of solutions received from the other solvers */
+SCIP_Longint SCIPeventhdlrPortfolioGetNImported(
+   SCIP*                 scip                 /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return 0;
+   return SCIPeventhdlrGetData(eventhdlr)->nimported;
+}
+
+/** creates the portfolio eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrPortfolio(
+   SCIP*                 scip,                /**< SCIP data structure */
+   portfolioSlotT*       slot                 /**< slot shared by the solvers */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+   eventhdlrdata->slot = slot;
+   eventhdlrdata->x = NULL;
+   eventhdlrdata->n = 0;
+   eventhdlrdata->imported = 0;
+   eventhdlrdata->hasimported = 0;
+   eventhdlrdata->nimported = 0;
+
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecPortfolio, eventhdlrdata) );
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreePortfolio) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolPortfolio) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolPortfolio) );
+
+   return SCIP_OKAY;
+}
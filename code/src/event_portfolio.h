@@ -0,0 +1,59 @@
+/**@file   event_portfolio.h
+ * @brief  eventhdlr that shares the incumbent value among the solvers of the portfolio mode
+ *
+ * Each solver of the portfolio pushes its best solutions (value and items) in a shared slot. At each node solved, a
+ * solver whose primal bound is worse than the value of the slot (read without locks) copies the items of the slot and
+ * tries them as a solution of its own SCIP (SCIPtrySol), so its pruning uses the best solution of the portfolio. The
+ * objective limit is not used: SCIPsetObjlimit can not be called while solving. When one solver proves optimality, the
+ * stop flag of the slot interrupts the other ones.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_PORTFOLIO_H__
+#define __SCIP_EVENT_PORTFOLIO_H__
+
+
+#include <pthread.h>
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** slot shared by the solvers of the portfolio (best and stop are read with atomic operations) */
+typedef struct{
+   long long best;    /**< best objective value found by any solver (the objective is integer; LLONG_MIN: none) */
+   int stop;          /**< 1 if some solver proved optimality */
+   int n;             /**< total of items of the instance (all solvers use copies of the same instance) */
+   int* x;            /**< items of the best solution (copies selected of each item) */
+   pthread_mutex_t lock; /**< protects x and the updates of best */
+} portfolioSlotT;
+
+void portfolioSlotInit(portfolioSlotT* slot, int n);
+void portfolioSlotFree(portfolioSlotT* slot);
+// offers a solution to the slot. Returns 1 if it is the new best solution
+int portfolioSlotPush(portfolioSlotT* slot, long long value, const int* x);
+// reads the best value of the slot without locks. Returns 0 if there is no value yet
+int portfolioSlotGet(portfolioSlotT* slot, long long* value);
+// copies the best solution of the slot in x. Returns 0 if there is no solution yet
+int portfolioSlotGetSol(portfolioSlotT* slot, long long* value, int* x);
+void portfolioSlotStop(portfolioSlotT* slot);
+int portfolioSlotStopped(portfolioSlotT* slot);
+
+/** returns the total of solutions received from the other solvers */
+SCIP_Longint SCIPeventhdlrPortfolioGetNImported(
+   SCIP*                 scip                 /**< SCIP data structure */
+   );
+
+/** creates the portfolio eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrPortfolio(
+   SCIP*                 scip,                /**< SCIP data structure */
+   portfolioSlotT*       slot                 /**< slot shared by the solvers */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
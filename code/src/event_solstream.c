@@ -0,0 +1,334 @@
+/**@file   event_solstream.c
+ * @brief  eventhdlr that streams each improving solution to files while SCIP is solving
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "event_solstream.h"
+#include "utils.h"
+
+#define EVENTHDLR_NAME         "solstream"
+#define EVENTHDLR_DESC         "writes each improving solution while solving"
+
+//#define DEBUG_SOLSTREAM 1
+
+/*
+ * Data structures
+ */
+
+/** one solution formatted by the solver thread, waiting for the writer thread */
+typedef struct solstreamRecord{
+   char*                 line;               /**< line of the .stream file */
+   char*                 sol;                /**< contents of the .sol file */
+   struct solstreamRecord* next;
+} solstreamRecordT;
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   char                  solname[SCIP_MAXSTRLEN]; /**< .sol file */
+   char                  tmpname[SCIP_MAXSTRLEN]; /**< temporary file renamed to the .sol file */
+   FILE*                 log;                /**< .stream file (NULL: it could not be created) */
+   solstreamRecordT*     first;              /**< records not written yet */
+   solstreamRecordT*     last;
+   int                   busy;               /**< 1 while the writer thread writes records out of the list */
+   int                   stop;               /**< 1: the writer thread stops when the list is empty */
+   SCIP_Longint          nsols;              /**< total of solutions streamed */
+   pthread_t             thread;
+   pthread_mutex_t       lock;
+   pthread_cond_t        work;               /**< signaled when a record is added or at stop */
+   pthread_cond_t        done;               /**< signaled when the writer thread finishes a list of records */
+};
+
+/*
+ * Local methods
+ */
+
+static void freeRecords(solstreamRecordT* record)
+{
+   solstreamRecordT* next;
+
+   for(; record != NULL; record = next){
+      next = record->next;
+      free(record->line);
+      free(record->sol);
+      free(record);
+   }
+}
+
+// writes the contents of the .sol file in a temporary file and renames it (the rename is atomic)
+static void rewriteSol(SCIP_EVENTHDLRDATA* eventhdlrdata, const char* sol)
+{
+   FILE* file;
+
+   file = fopen(eventhdlrdata->tmpname, "w");
+   if(file == NULL)
+      return;
+   fputs(sol, file);
+   if(fclose(file) == 0)
+      (void) rename(eventhdlrdata->tmpname, eventhdlrdata->solname);
+}
+
+/** writer thread: takes all records at once, appends them to the log and writes only the newest .sol */
+static void* solstreamWriter(void* arg)
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata = (SCIP_EVENTHDLRDATA*) arg;
+   solstreamRecordT* records, *record;
+
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   for(;;){
+      while(eventhdlrdata->first == NULL && !eventhdlrdata->stop)
+         pthread_cond_wait(&eventhdlrdata->work, &eventhdlrdata->lock);
+      if(eventhdlrdata->first == NULL)
+         break;
+      records = eventhdlrdata->first;
+      eventhdlrdata->first = eventhdlrdata->last = NULL;
+      eventhdlrdata->busy = 1;
+      pthread_mutex_unlock(&eventhdlrdata->lock);
+
+      for(record = records; record != NULL; record = record->next){
+         if(eventhdlrdata->log != NULL)
+            fputs(record->line, eventhdlrdata->log);
+         if(record->next == NULL)
+            rewriteSol(eventhdlrdata, record->sol);
+      }
+      if(eventhdlrdata->log != NULL)
+         fflush(eventhdlrdata->log);
+      freeRecords(records);
+
+      pthread_mutex_lock(&eventhdlrdata->lock);
+      eventhdlrdata->busy = 0;
+      pthread_cond_broadcast(&eventhdlrdata->done);
+   }
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+   return NULL;
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeSolstream)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   // the writer thread writes the records left and stops
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   eventhdlrdata->stop = 1;
+   pthread_cond_signal(&eventhdlrdata->work);
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+   pthread_join(eventhdlrdata->thread, NULL);
+
+   if(eventhdlrdata->log != NULL)
+      fclose(eventhdlrdata->log);
+   pthread_cond_destroy(&eventhdlrdata->done);
+   pthread_cond_destroy(&eventhdlrdata->work);
+   pthread_mutex_destroy(&eventhdlrdata->lock);
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolSolstream)
+{  /*lint --e{715}*/
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolSolstream)
+{  /*lint --e{715}*/
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, -1) );
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler: formats the solution and hands it to the writer thread */
+static
+SCIP_DECL_EVENTEXEC(eventExecSolstream)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   solstreamRecordT* record;
+   SCIP_SOL* sol;
+   SCIP_HEUR* heur;
+   struct timespec now;
+   FILE* mem;
+   size_t size;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   sol = SCIPeventGetSol(event);
+   assert(sol != NULL);
+   heur = SCIPsolGetHeur(sol);
+   clock_gettime(CLOCK_REALTIME, &now);
+
+   record = (solstreamRecordT*) malloc(sizeof(solstreamRecordT));
+   record->next = NULL;
+   mem = open_memstream(&record->line, &size);
+   fprintf(mem, "%.3lf %.2lf %.0lf %s ", now.tv_sec + now.tv_nsec*1e-9, SCIPgetSolvingTime(scip),
+      SCIPgetSolOrigObj(scip, sol), heur != NULL ? SCIPheurGetName(heur) : "relaxation");
+   fprintSolItems(scip, sol, mem);
+   fprintf(mem, "\n");
+   fclose(mem);
+   mem = open_memstream(&record->sol, &size);
+   fprintSol(scip, sol, mem);
+   fclose(mem);
+#ifdef DEBUG_SOLSTREAM
+   printf("\nSolstream: %s", record->line);
+#endif
+
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   if(eventhdlrdata->last != NULL)
+      eventhdlrdata->last->next = record;
+   else
+      eventhdlrdata->first = record;
+   eventhdlrdata->last = record;
+   eventhdlrdata->nsols++;
+   pthread_cond_signal(&eventhdlrdata->work);
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** waits until the writer thread wrote all solutions found so far */
+void SCIPeventhdlrSolstreamFlush(
+   SCIP*                 scip                 /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return;
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   while(eventhdlrdata->first != NULL || eventhdlrdata->busy)
+      pthread_cond_wait(&eventhdlrdata->done, &eventhdlrdata->lock);
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+}
+
+/** writes the next solutions in <outputname>.stream and <outputname>.sol, after the ones found so far were written in the
+ *  previous files
+ */
+void SCIPeventhdlrSolstreamSetOutput(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   char logname[SCIP_MAXSTRLEN];
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return;
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   // the writer thread is idle after the flush, and only the solver thread (this one) adds records
+   SCIPeventhdlrSolstreamFlush(scip);
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   if(eventhdlrdata->log != NULL)
+      fclose(eventhdlrdata->log);
+   (void) SCIPsnprintf(eventhdlrdata->solname, SCIP_MAXSTRLEN, "%s.sol", outputname);
+   (void) SCIPsnprintf(eventhdlrdata->tmpname, SCIP_MAXSTRLEN, "%s.sol.tmp", outputname);
+   (void) SCIPsnprintf(logname, SCIP_MAXSTRLEN, "%s.stream", outputname);
+   eventhdlrdata->log = fopen(logname, "w");
+   if(eventhdlrdata->log == NULL)
+      printf("\nProblem to create solution stream file: %s", logname);
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+}
+
+/** returns the total of solutions streamed */
+SCIP_Longint SCIPeventhdlrSolstreamGetNSols(
+   SCIP*                 scip                 /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_Longint nsols;
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return 0;
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   pthread_mutex_lock(&eventhdlrdata->lock);
+   nsols = eventhdlrdata->nsols;
+   pthread_mutex_unlock(&eventhdlrdata->lock);
+   return nsols;
+}
+
+/** creates the solstream eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrSolstream(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+   char logname[SCIP_MAXSTRLEN];
+
+   /* create event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+   (void) SCIPsnprintf(eventhdlrdata->solname, SCIP_MAXSTRLEN, "%s.sol", outputname);
+   (void) SCIPsnprintf(eventhdlrdata->tmpname, SCIP_MAXSTRLEN, "%s.sol.tmp", outputname);
+   (void) SCIPsnprintf(logname, SCIP_MAXSTRLEN, "%s.stream", outputname);
+   eventhdlrdata->log = fopen(logname, "w");
+   if(eventhdlrdata->log == NULL)
+      printf("\nProblem to create solution stream file: %s", logname);
+   eventhdlrdata->first = eventhdlrdata->last = NULL;
+   eventhdlrdata->busy = 0;
+   eventhdlrdata->stop = 0;
+   eventhdlrdata->nsols = 0;
+   pthread_mutex_init(&eventhdlrdata->lock, NULL);
+   pthread_cond_init(&eventhdlrdata->work, NULL);
+   pthread_cond_init(&eventhdlrdata->done, NULL);
+   if(pthread_create(&eventhdlrdata->thread, NULL, solstreamWriter, eventhdlrdata) != 0){
+      printf("\nProblem to create the writer thread of the solution stream\n");
+      if(eventhdlrdata->log != NULL)
+         fclose(eventhdlrdata->log);
+      pthread_cond_destroy(&eventhdlrdata->done);
+      pthread_cond_destroy(&eventhdlrdata->work);
+      pthread_mutex_destroy(&eventhdlrdata->lock);
+      SCIPfreeMemory(scip, &eventhdlrdata);
+      return SCIP_ERROR;
+   }
+
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecSolstream, eventhdlrdata) );
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions; there is no copy callback on purpose: the sub-SCIPs of the
+    * heuristics may change the objective or find solutions worse than the incumbent, and a copy would write them in the
+    * output files of the main solve (the solutions of the concurrent solvers are streamed when they reach the main SCIP)
+    */
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeSolstream) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolSolstream) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolSolstream) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,51 @@
+/**@file   event_solstream.h
+ * @brief  eventhdlr that streams each improving solution to files while SCIP is solving
+ *
+ * At each new best solution, the solver thread only formats the solution in memory; a writer thread appends one line
+ * "<epoch time> <solving time> <objective> <heuristic> <items 1..n>" to <output>.stream and rewrites <output>.sol
+ * (written in <output>.sol.tmp and renamed, so a reader never sees an incomplete file). If the process is killed, the
+ * .sol file has the last solution written. The re-optimization rounds stream to <output>-reopt<round>.stream and .sol,
+ * so the files of the base solve are kept.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_SOLSTREAM_H__
+#define __SCIP_EVENT_SOLSTREAM_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** waits until the writer thread wrote all solutions found so far */
+void SCIPeventhdlrSolstreamFlush(
+   SCIP*                 scip                 /**< SCIP data structure */
+   );
+
+/** writes the next solutions in <outputname>.stream and <outputname>.sol, after the ones found so far were written in the
+ *  previous files
+ */
+void SCIPeventhdlrSolstreamSetOutput(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   );
+
+/** returns the total of solutions streamed */
+SCIP_Longint SCIPeventhdlrSolstreamGetNSols(
+   SCIP*                 scip                 /**< SCIP data structure */
+   );
+
+/** creates the solstream eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrSolstream(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
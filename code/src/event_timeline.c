@@ -0,0 +1,277 @@
+/**@file   event_timeline.c
+ * @brief  eventhdlr that records the trajectory of the primal and dual bounds
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "event_timeline.h"
+#include "run_mochila.h"
+
+#define EVENTHDLR_NAME         "timeline"
+#define EVENTHDLR_DESC         "records the primal and dual bounds over the time"
+
+#define EVENTTYPE_TIMELINE     (SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED)
+
+//#define DEBUG_TIMELINE 1
+
+/*
+ * Data structures
+ */
+
+/** one point of the timeline */
+typedef struct{
+   double                time;               /**< wall time since the start of the solve */
+   SCIP_Longint          node;               /**< nodes solved */
+   double                primal;
+   double                dual;
+   const char*           heur;               /**< heuristic of the new solution (NULL: only the dual bound changed) */
+} timelinePointT;
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   const parametersT*    param;              /**< pointer to the config parameters */
+   timelinePointT*       points;
+   int                   npoints;
+   int                   maxpoints;
+   double                start;              /**< wall time of the start of the solve */
+   double                end;                /**< time of the last event */
+   double                lastdual;
+};
+
+/*
+ * Local methods
+ */
+
+static SCIP_RETCODE addPoint(SCIP* scip, SCIP_EVENTHDLRDATA* eventhdlrdata, double primal, const char* heur)
+{
+   timelinePointT* point;
+
+   if(eventhdlrdata->npoints == eventhdlrdata->maxpoints){
+      eventhdlrdata->maxpoints = 2*eventhdlrdata->maxpoints + 64;
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &eventhdlrdata->points, eventhdlrdata->maxpoints) );
+   }
+   point = &eventhdlrdata->points[eventhdlrdata->npoints++];
+   point->time = eventhdlrdata->end;
+   point->node = SCIPgetNNodes(scip);
+   point->primal = primal;
+   point->dual = SCIPgetDualbound(scip);
+   point->heur = heur;
+   eventhdlrdata->lastdual = point->dual;
+#ifdef DEBUG_TIMELINE
+   printf("\nTimeline: %.3lf node %lld primal %lf dual %lf %s", point->time, point->node, point->primal, point->dual, heur != NULL ? heur : "-");
+#endif
+   return SCIP_OKAY;
+}
+
+// primal gap of the value z to the reference value (Berthold): 1 without solution or with different signs
+static double primalGap(SCIP* scip, double reference, double z)
+{
+   if(SCIPisZero(scip, reference) && SCIPisZero(scip, z))
+      return 0.0;
+   if(reference * z < 0.0)
+      return 1.0;
+   return fabs(reference - z) / MAX(fabs(reference), fabs(z));
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** copy method for event handler plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_EVENTCOPY(eventCopyTimeline)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(eventhdlr != NULL);
+
+   /* call inclusion method of event handler (the copy records its own timeline) */
+   SCIP_CALL( SCIPincludeEventhdlrTimeline(scip, SCIPeventhdlrGetData(eventhdlr)->param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeTimeline)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPfreeMemoryArrayNull(scip, &eventhdlrdata->points);
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolTimeline)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   // each solve (as the solves of the re-optimization) has its own timeline
+   eventhdlrdata->npoints = 0;
+   eventhdlrdata->start = wallTime();
+   eventhdlrdata->end = 0.0;
+   eventhdlrdata->lastdual = SCIPinfinity(scip);
+
+   SCIP_CALL( SCIPcatchEvent(scip, EVENTTYPE_TIMELINE, eventhdlr, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolTimeline)
+{  /*lint --e{715}*/
+
+   SCIP_CALL( SCIPdropEvent(scip, EVENTTYPE_TIMELINE, eventhdlr, NULL, -1) );
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static
+SCIP_DECL_EVENTEXEC(eventExecTimeline)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_SOL* sol;
+   SCIP_HEUR* heur;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->end = wallTime() - eventhdlrdata->start;
+   if(SCIPeventGetType(event) == SCIP_EVENTTYPE_BESTSOLFOUND){
+      sol = SCIPeventGetSol(event);
+      heur = SCIPsolGetHeur(sol);
+      SCIP_CALL( addPoint(scip, eventhdlrdata, SCIPgetSolOrigObj(scip, sol), heur != NULL ? SCIPheurGetName(heur) : "relaxation") );
+   }
+   else if(!SCIPisEQ(scip, SCIPgetDualbound(scip), eventhdlrdata->lastdual)){
+      SCIP_CALL( addPoint(scip, eventhdlrdata, SCIPgetPrimalbound(scip), NULL) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/*
+ * event handler specific interface methods
+ */
+
+/** computes the summary of the timeline (returns 0 if the eventhdlr was not included) */
+int SCIPeventhdlrTimelineGetSummary(
+   SCIP*                 scip,                /**< SCIP data structure */
+   timelineSummaryT*     summary              /**< summary of the timeline */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   timelinePointT* point;
+   double reference, gap, last;
+   int p;
+
+   summary->npoints = 0;
+   summary->primalintegral = 0.0;
+   summary->timetotarget = -1.0;
+   summary->firstsol = -1.0;
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return 0;
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   summary->npoints = eventhdlrdata->npoints;
+
+   // the reference is the final primal bound: the gap is 1 until the first solution
+   reference = SCIPgetPrimalbound(scip);
+   gap = 1.0;
+   last = 0.0;
+   for(p=0;p<eventhdlrdata->npoints;p++){
+      point = &eventhdlrdata->points[p];
+      if(point->heur == NULL)
+         continue;
+      summary->primalintegral += gap * (point->time - last);
+      last = point->time;
+      gap = primalGap(scip, reference, point->primal);
+      if(summary->firstsol < 0.0)
+         summary->firstsol = point->time;
+      if(summary->timetotarget < 0.0 && gap <= eventhdlrdata->param->timeline_target + 1e-9)
+         summary->timetotarget = point->time;
+   }
+   summary->primalintegral += gap * (eventhdlrdata->end - last);
+   return 1;
+}
+
+/** writes the points of the timeline in <outputname>.timeline */
+SCIP_RETCODE SCIPeventhdlrTimelineWrite(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   timelinePointT* point;
+   char filename[SCIP_MAXSTRLEN];
+   FILE* fout;
+   int p;
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   if(eventhdlr == NULL)
+      return SCIP_OKAY;
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+
+   (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s.timeline", outputname);
+   fout = fopen(filename, "w");
+   if(!fout){
+      printf("\nProblem to create file %s\n", filename);
+      return SCIP_FILECREATEERROR;
+   }
+   fprintf(fout, "time;node;primal;dual;heur\n");
+   for(p=0;p<eventhdlrdata->npoints;p++){
+      point = &eventhdlrdata->points[p];
+      fprintf(fout, "%.3lf;%lld;%.10g;%.10g;%s\n", point->time, point->node, point->primal, point->dual, point->heur != NULL ? point->heur : "-");
+   }
+   fclose(fout);
+   return SCIP_OKAY;
+}
+
+/** creates the timeline eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrTimeline(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT*    param                /**< parameters (timeline_target) */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_EVENTHDLR* eventhdlr;
+
+   /* create event handler data */
+   SCIP_CALL( SCIPallocMemory(scip, &eventhdlrdata) );
+   eventhdlrdata->param = param;
+   eventhdlrdata->points = NULL;
+   eventhdlrdata->npoints = 0;
+   eventhdlrdata->maxpoints = 0;
+   eventhdlrdata->start = wallTime();
+   eventhdlrdata->end = 0.0;
+   eventhdlrdata->lastdual = SCIPinfinity(scip);
+
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecTimeline, eventhdlrdata) );
+   assert(eventhdlr != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetEventhdlrCopy(scip, eventhdlr, eventCopyTimeline) );
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeTimeline) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolTimeline) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolTimeline) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,53 @@
+/**@file   event_timeline.h
+ * @brief  eventhdlr that records the trajectory of the primal and dual bounds
+ *
+ * A point (wall time, node, primal, dual, heuristic) is recorded at each new best solution and at each node that
+ * changes the dual bound. At the end, the primal integral (integral over time of the primal gap to the final primal
+ * bound, as defined by Berthold) and the time to reach a primal gap of at most --timeline_target are computed from the
+ * points. The points are written in <output>.timeline.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_TIMELINE_H__
+#define __SCIP_EVENT_TIMELINE_H__
+
+
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** summary of the timeline of the last solve */
+typedef struct{
+   int npoints;            /**< total of points recorded */
+   double primalintegral;  /**< primal integral (in sec) */
+   double timetotarget;    /**< wall time to reach the target primal gap (-1: not reached) */
+   double firstsol;        /**< wall time of the first solution (-1: no solution) */
+} timelineSummaryT;
+
+/** computes the summary of the timeline (returns 0 if the eventhdlr was not included) */
+int SCIPeventhdlrTimelineGetSummary(
+   SCIP*                 scip,                /**< SCIP data structure */
+   timelineSummaryT*     summary              /**< summary of the timeline */
+   );
+
+/** writes the points of the timeline in <outputname>.timeline */
+SCIP_RETCODE SCIPeventhdlrTimelineWrite(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const char*           outputname           /**< name of the output files, without extension */
+   );
+
+/** creates the timeline eventhdlr and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventhdlrTimeline(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT*    param                /**< parameters (timeline_target) */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,131 @@
+/**@file   heap.c
+ * @brief  indexed max-heap of items 0..size-1 with double keys
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include "heap.h"
+
+static void heapSwap(heapT* H, int p, int q)
+{
+   int t;
+
+   t = H->elem[p];
+   H->elem[p] = H->elem[q];
+   H->elem[q] = t;
+   H->pos[H->elem[p]] = p;
+   H->pos[H->elem[q]] = q;
+}
+static void heapUp(heapT* H, int p)
+{
+   while(p > 0 && H->key[H->elem[(p-1)/2]] < H->key[H->elem[p]]){
+      heapSwap(H, p, (p-1)/2);
+      p = (p-1)/2;
+   }
+}
+static void heapDown(heapT* H, int p)
+{
+   int c;
+
+   while((c = 2*p+1) < H->n){
+      if(c+1 < H->n && H->key[H->elem[c+1]] > H->key[H->elem[c]])
+         c++;
+      if(H->key[H->elem[c]] <= H->key[H->elem[p]])
+         break;
+      heapSwap(H, p, c);
+      p = c;
+   }
+}
+void heapCreate(heapT** H, int size)
+{
+   int i;
+
+   *H = (heapT*) malloc(sizeof(heapT));
+   (*H)->n = 0;
+   (*H)->size = size;
+   (*H)->elem = (int*) malloc(sizeof(int)*(size+1));
+   (*H)->pos = (int*) malloc(sizeof(int)*(size+1));
+   (*H)->key = (double*) malloc(sizeof(double)*(size+1));
+   for(i=0;i<size;i++)
+      (*H)->pos[i] = -1;
+}
+void heapFree(heapT** H)
+{
+   if(*H){
+      free((*H)->elem);
+      free((*H)->pos);
+      free((*H)->key);
+      free(*H);
+      *H = NULL;
+   }
+}
+void heapClear(heapT* H)
+{
+   int p;
+
+   for(p=0;p<H->n;p++)
+      H->pos[H->elem[p]] = -1;
+   H->n = 0;
+}
+void heapInsert(heapT* H, int i, double key)
+{
+   H->key[i] = key;
+   H->elem[H->n] = i;
+   H->pos[i] = H->n++;
+   heapUp(H, H->pos[i]);
+}
+void heapRemove(heapT* H, int i)
+{
+   int p;
+
+   p = H->pos[i];
+   if(p < 0)
+      return;
+   H->n--;
+   if(p != H->n){
+      heapSwap(H, p, H->n);
+      heapUp(H, p);
+      heapDown(H, H->pos[H->elem[p]]);
+   }
+   H->pos[i] = -1;
+}
+void heapUpdate(heapT* H, int i, double key)
+{
+   double old;
+
+   old = H->key[i];
+   H->key[i] = key;
+   if(key > old)
+      heapUp(H, H->pos[i]);
+   else
+      heapDown(H, H->pos[i]);
+}
+int heapTop(heapT* H)
+{
+   return H->n > 0 ? H->elem[0] : -1;
+}
+int heapContains(heapT* H, int i)
+{
+   return H->pos[i] >= 0;
+}
+int heapCollect(heapT* H, double threshold, int* list)
+{
+   int p, nlist, top, *stack;
+
+   // depth first search from the root: the children of an item below the threshold are also below it
+   nlist = 0;
+   if(H->n == 0 || H->key[H->elem[0]] < threshold)
+      return 0;
+   stack = (int*) malloc(sizeof(int)*H->n);
+   top = 0;
+   stack[top++] = 0;
+   while(top > 0){
+      p = stack[--top];
+      list[nlist++] = H->elem[p];
+      if(2*p+1 < H->n && H->key[H->elem[2*p+1]] >= threshold)
+         stack[top++] = 2*p+1;
+      if(2*p+2 < H->n && H->key[H->elem[2*p+2]] >= threshold)
+         stack[top++] = 2*p+2;
+   }
+   free(stack);
+   return nlist;
+}
@@ -0,0 +1,30 @@
+/**@file   heap.h
+ * @brief  indexed max-heap of items 0..size-1 with double keys
+ *
+ * pos[] keeps the position of each item in the heap (-1 if it is not there), so the key of any item can be updated or
+ * the item removed in O(log n).
+ **/
+#ifndef __HEAP__
+#define __HEAP__
+
+typedef struct{
+   int n;             /**< total of items in the heap */
+   int size;          /**< maximum of items (items are 0..size-1) */
+   int* elem;         /**< elem[p] is the item in the position p of the heap */
+   int* pos;          /**< pos[i] is the position of item i in the heap, -1 if it is not in the heap */
+   double* key;       /**< key[i] is the key of item i */
+} heapT;
+
+void heapCreate(heapT** H, int size);
+void heapFree(heapT** H);
+void heapClear(heapT* H);
+void heapInsert(heapT* H, int i, double key);
+void heapRemove(heapT* H, int i);
+// change the key of item i (it must be in the heap)
+void heapUpdate(heapT* H, int i, double key);
+// item with maximum key (-1 if the heap is empty)
+int heapTop(heapT* H);
+int heapContains(heapT* H, int i);
+// save in list the items with key >= threshold and returns the total of them
+int heapCollect(heapT* H, double threshold, int* list);
+#endif
@@ -21,11 +21,14 @@
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
 #include <assert.h>
+#include <math.h>
 
 #include "probdata_mochila.h"
 #include "parameters_mochila.h"
 #include "heur_aleatoria.h"
 #include "utils.h"
+#include "solstate.h"
+#include "heap.h"
 //#include "heur_problem.h"
 /* configuracao da heuristica */
 #define HEUR_NAME             "aleatoria"
@@ -38,6 +41,9 @@
 #define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
 #define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
 
+#define GRASP_LSMAXPASS       10 /**< maximum of passes of the local search after each GRASP construction */
+#define LP_MINWEIGHT          0.001 /**< sampling weight of the items with LP value 0 (they are sampled last) */
+
 #ifdef DEBUG
    #define PRINTF(...) printf(__VA_ARGS__)
 #else
@@ -60,7 +66,182 @@
  * Local methods
  */
 
-/* put your local methods here, and declare them static */
+/** greedy score of item i: value minus the forfeit costs it would pay now, per unit of weight */
+static
+double graspScore(solstateT* S, int i, int delta)
+{
+   return (double) delta / (S->I->item[i].weight > 0 ? S->I->item[i].weight : 1);
+}
+
+/**
+ * @brief local search over add, drop and swap moves (first improvement) of the items that are not fixed.
+ *
+ * @param S solution to be improved
+ * @param canChange canChange[i]=1 if item i is not fixed in the current node
+ */
+static
+void graspLocalSearch(solstateT* S, int* canChange)
+{
+   instanceT* I;
+   int i, j, pass, improved, dr, da, best, bestj;
+
+   I = S->I;
+   improved = 1;
+   for(pass=0;pass<GRASP_LSMAXPASS && improved;pass++){
+      improved = 0;
+      // add and drop moves
+      for(i=0;i<I->n;i++){
+         if(!canChange[i])
+            continue;
+         if(!S->x[i] && solstateCanAdd(S, i) && solstateDeltaAdd(S, i, NULL) > 0){
+            solstateAdd(S, i);
+            improved = 1;
+         }
+         else if(S->x[i] && solstateDeltaRemove(S, i, NULL) > 0){
+            solstateRemove(S, i);
+            improved = 1;
+         }
+      }
+      // swap moves: item i leaves the solution and the best item j enters
+      for(i=0;i<I->n;i++){
+         if(!canChange[i] || !S->x[i])
+            continue;
+         dr = solstateDeltaRemove(S, i, NULL);
+         solstateRemove(S, i);
+         best = 0;
+         bestj = -1;
+         for(j=0;j<I->n;j++){
+            if(j == i || !canChange[j] || !solstateCanAdd(S, j))
+               continue;
+            da = solstateDeltaAdd(S, j, NULL);
+            if(dr + da > best){
+               best = dr + da;
+               bestj = j;
+            }
+         }
+         if(bestj >= 0){
+            solstateAdd(S, bestj);
+            improved = 1;
+         }
+         else{
+            solstateAdd(S, i);
+         }
+      }
+   }
+}
+
+/**
+ * @brief GRASP construction: items are scored by graspScore() in an indexed heap, and each step selects an item at
+ * random among the candidates with score >= (1-alpha)*(best score). The score of an item only changes when one of its
+ * forfeit sets reaches h items, so only the items of those sets are updated. The solution is improved by
+ * graspLocalSearch().
+ *
+ * @return int 1 if solutions is found, 0 otherwise.
+ */
+static
+int grasp(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** varlist;
+   instanceT* I;
+   const parametersT* param;
+   solstateT* S;
+   heapT* H;
+   unsigned int stored;
+   int i, j, s, t, ii, found, delta, nList, nKept, selected, *canChange, *list;
+   double threshold, tprof;
+   heurProfileT* profile;
+
+   found = 0;
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   varlist = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   param = SCIPprobdataGetParam(probdata);
+   profile = SCIPprobdataGetProfile(probdata, PROFILE_ALEATORIA);
+
+   solstateCreate(&S, I);
+   canChange = (int*) malloc(sizeof(int)*I->n);
+   // items fixed in the current node
+   for(i=0;i<I->n;i++){
+      canChange[i] = 0;
+      if(SCIPvarGetLbLocal(varlist[i]) > 1.0 - EPSILON)
+         solstateAdd(S, i);
+      else if(SCIPvarGetUbLocal(varlist[i]) >= EPSILON)
+         canChange[i] = 1;
+   }
+   if(!solstateFeasible(S)){
+      free(canChange);
+      solstateFree(&S);
+      return 0;
+   }
+   // candidates: the penalties only grow, so items with non positive value now will never be interesting
+   heapCreate(&H, I->n);
+   for(i=0;i<I->n;i++){
+      if(canChange[i] && solstateCanAdd(S, i)){
+         delta = solstateDeltaAdd(S, i, NULL);
+         if(delta > 0)
+            heapInsert(H, i, graspScore(S, i, delta));
+      }
+   }
+   list = (int*) malloc(sizeof(int)*I->n);
+   while(heapTop(H) >= 0){
+      threshold = (1.0 - param->grasp_alpha)*H->key[heapTop(H)];
+      nList = heapCollect(H, threshold, list);
+      // discard the candidates that do not fit anymore (capacity and violations only grow)
+      nKept = 0;
+      for(s=0;s<nList;s++){
+         if(solstateCanAdd(S, list[s]))
+            list[nKept++] = list[s];
+         else
+            heapRemove(H, list[s]);
+      }
+      if(nKept == 0)
+         continue;
+      selected = list[RandomInteger(SCIPprobdataGetRandnumgen(probdata), 0, nKept-1)];
+      heapRemove(H, selected);
+      solstateAdd(S, selected);
+#ifdef DEBUG_ALEATORIA
+      printf("\nGRASP selected item %d (RCL=%d). value=%d weight=%d violations=%d", selected, nKept, S->value, S->weight, S->violations);
+#endif
+      // update the items of the sets that have just reached h items
+      for(j=0;j<I->item[selected].nsets;j++){
+         ii = I->item[selected].set[j];
+         if(S->count[ii] != I->S[ii].h)
+            continue;
+         for(t=0;t<I->S[ii].n;t++){
+            i = I->S[ii].items[t];
+            if(!heapContains(H, i))
+               continue;
+            delta = solstateDeltaAdd(S, i, NULL);
+            if(delta > 0)
+               heapUpdate(H, i, graspScore(S, i, delta));
+            else
+               heapRemove(H, i);
+         }
+      }
+   }
+   graspLocalSearch(S, canChange);
+
+   if(solstateFeasible(S) && S->value > SCIPgetPrimalbound(scip) + EPSILON){
+      tprof = profileStart(profile);
+      SCIP_CALL( createSolFromItems(scip, heur, S->x, sol) );
+      profileStop(profile, PROFILE_TRANSFER, tprof);
+      tprof = profileStart(profile);
+      SCIP_CALL( SCIPtrySolMine(scip, *sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      profileStop(profile, PROFILE_TRYSOL, tprof);
+      SCIP_CALL( SCIPfreeSol(scip, sol) );
+      found = stored ? 1 : 0;
+#ifdef DEBUG_PRIMAL
+      printf("\nGRASP solution value=%d stored=%d", S->value, found);
+#endif
+   }
+   free(list);
+   heapFree(&H);
+   free(canChange);
+   solstateFree(&S);
+   return found;
+}
 
 /*
  * Callback methods of primal heuristic
@@ -72,6 +253,16 @@
 static
 SCIP_DECL_HEURCOPY(heurCopyAleatoria)
 {  /*lint --e{715}*/
+   parametersT param;
+
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* the inclusion only uses the frequency settings; the other parameters are read from the problem data */
+   param.heur_freq = SCIPheurGetFreq(heur);
+   param.heur_freqofs = SCIPheurGetFreqofs(heur);
+   param.heur_maxdepth = SCIPheurGetMaxdepth(heur);
+   SCIP_CALL( SCIPincludeHeurAleatoria(scip, &param) );
 
    return SCIP_OKAY;
 }
@@ -122,6 +313,119 @@ SCIP_DECL_HEUREXITSOL(heurExitsolAleatoria)
 }
 
 
+/** sampling key of one item */
+typedef struct{
+   double key;
+   int i;
+} lpKeyT;
+
+/** decreasing order of keys */
+static
+int compareLpKey(const void* a, const void* b)
+{
+   if(((lpKeyT*)a)->key < ((lpKeyT*)b)->key) return 1;
+   if(((lpKeyT*)a)->key > ((lpKeyT*)b)->key) return -1;
+   return 0;
+}
+
+/**
+ * @brief LP-guided randomized rounding: the free items are sorted by the keys u^(1/lp_i), u uniform in (0,1)
+ * (Efraimidis and Spirakis), which is a random order where the item in each position is drawn with probability
+ * proportional to its LP value among the remaining ones. Items are added in this order while they fit in the
+ * capacity and have positive value, without looking at the limit k. Then the violations are repaired by greedily
+ * removing the item that reduces the violations with the smallest loss, and the solution is completed in the same order.
+ *
+ * @return int 1 if solutions is found, 0 otherwise.
+ */
+static
+int lpRounding(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** varlist;
+   instanceT* I;
+   solstateT* S;
+   lpKeyT* order;
+   unsigned int stored;
+   int i, t, found, norder, dviol, delta, best, bestdelta, *canChange;
+   double lpval, tprof;
+   heurProfileT* profile;
+
+   found = 0;
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   varlist = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   profile = SCIPprobdataGetProfile(probdata, PROFILE_ALEATORIA);
+
+   solstateCreate(&S, I);
+   canChange = (int*) malloc(sizeof(int)*I->n);
+   order = (lpKeyT*) malloc(sizeof(lpKeyT)*I->n);
+   norder = 0;
+   for(i=0;i<I->n;i++){
+      canChange[i] = 0;
+      if(SCIPvarGetLbLocal(varlist[i]) > 1.0 - EPSILON){
+         solstateAdd(S, i);
+      }
+      else if(SCIPvarGetUbLocal(varlist[i]) >= EPSILON){
+         canChange[i] = 1;
+         lpval = SCIPgetSolVal(scip, NULL, varlist[i]);
+         order[norder].key = pow(RandomDouble(SCIPprobdataGetRandnumgen(probdata)), 1.0/(lpval > LP_MINWEIGHT ? lpval : LP_MINWEIGHT));
+         order[norder++].i = i;
+      }
+   }
+   qsort(order, norder, sizeof(lpKeyT), compareLpKey);
+   // rounding: capacity is respected, violations are repaired later
+   for(t=0;t<norder && S->weight <= I->C;t++){
+      i = order[t].i;
+      if(S->weight + I->item[i].weight <= I->C && solstateDeltaAdd(S, i, NULL) > 0)
+         solstateAdd(S, i);
+   }
+   // repair the forfeit violations
+   while(S->weight <= I->C && S->violations > I->k){
+      best = -1;
+      bestdelta = 0;
+      for(i=0;i<I->n;i++){
+         if(!canChange[i] || !S->x[i])
+            continue;
+         delta = solstateDeltaRemove(S, i, &dviol);
+         if(dviol < 0 && (best < 0 || delta > bestdelta)){
+            best = i;
+            bestdelta = delta;
+         }
+      }
+      if(best < 0)
+         break;
+      solstateRemove(S, best);
+#ifdef DEBUG_ALEATORIA
+      printf("\nLP rounding: item %d removed. value=%d violations=%d", best, S->value, S->violations);
+#endif
+   }
+   // complete the solution in the same order
+   for(t=0;t<norder && solstateFeasible(S);t++){
+      i = order[t].i;
+      if(solstateCanAdd(S, i) && solstateDeltaAdd(S, i, NULL) > 0)
+         solstateAdd(S, i);
+   }
+
+   if(solstateFeasible(S) && S->value > SCIPgetPrimalbound(scip) + EPSILON){
+      tprof = profileStart(profile);
+      SCIP_CALL( createSolFromItems(scip, heur, S->x, sol) );
+      profileStop(profile, PROFILE_TRANSFER, tprof);
+      tprof = profileStart(profile);
+      SCIP_CALL( SCIPtrySolMine(scip, *sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      profileStop(profile, PROFILE_TRYSOL, tprof);
+      SCIP_CALL( SCIPfreeSol(scip, sol) );
+      found = stored ? 1 : 0;
+#ifdef DEBUG_PRIMAL
+      printf("\nLP rounding solution value=%d stored=%d", S->value, found);
+#endif
+   }
+   free(order);
+   free(canChange);
+   solstateFree(&S);
+   return found;
+}
+
 /**
  * @brief Core of the aleatoria heuristic: it builds one solution for the problem by aleatoria procedure.
  *
@@ -142,7 +446,14 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    SCIP_PROBDATA* probdata;
    int i, residual, j, peso, nS, ii, toBeViolated;
    instanceT* I;
+   heurProfileT* profile;
+   double tprof;
    
+   if(SCIPprobdataGetParam(SCIPgetProbData(scip))->aleatoria_mode == ALEATORIA_GRASP)
+      return grasp(scip, sol, heur);
+   if(SCIPprobdataGetParam(SCIPgetProbData(scip))->aleatoria_mode == ALEATORIA_LP)
+      return lpRounding(scip, sol, heur);
+
    found = 0;
    infeasible = 0;
    
@@ -157,6 +468,7 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    nvars = SCIPprobdataGetNVars(probdata);
    varlist = SCIPprobdataGetVars(probdata);
    I = SCIPprobdataGetInstance(probdata);
+   profile = SCIPprobdataGetProfile(probdata, PROFILE_ALEATORIA);
    n = I->n;
    nS = I->nS; // nS = total de forfeit sets
     
@@ -216,7 +528,7 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    }
    // complete solution using items not fixed (not covered)
    for(i=0;i<n && !infeasible && nCands > 0 && residual>0;i++){
-      s = RandomInteger (0, nCands-1);
+      s = RandomInteger(SCIPprobdataGetRandnumgen(probdata), 0, nCands-1);
       selected = cand[s]; // selected candidate
       cand[s] = cand[--nCands]; // remove selected candidate
       // only accept the item if not covered yet and not exceed the capacity
@@ -264,6 +576,7 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    }
    if(!infeasible){
       /* create SCIP solution structure sol */
+      tprof = profileStart(profile);
       SCIP_CALL( SCIPcreateSol(scip, sol, heur) );
       // save found solution in sol
       for(i=0;i<nInSolution;i++){
@@ -275,6 +588,7 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
          valor = forfeit[j]>I->S[j].h?forfeit[j]-I->S[j].h:0;
          SCIP_CALL( SCIPsetSolVal(scip, *sol, varlist[I->n+j], (double) valor) );
       }
+      profileStop(profile, PROFILE_TRANSFER, tprof);
       bestUb = SCIPgetPrimalbound(scip);
 #ifdef DEBUG_ALEATORIA
       printf("\nFound solution...\n");
@@ -287,7 +601,9 @@ int aleatoria(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
 #endif
          
          /* check if the solution is feasible */
+         tprof = profileStart(profile);
          SCIP_CALL( SCIPtrySolMine(scip, *sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+         profileStop(profile, PROFILE_TRYSOL, tprof);
          if( stored )
          {
 #ifdef DEBUG_PRIMAL
@@ -317,7 +633,8 @@ static
 SCIP_DECL_HEUREXEC(heurExecAleatoria)
 {  /*lint --e{715}*/
    SCIP_SOL*             sol;                /**< solution to round */
-   int nlpcands;
+   heurProfileT*         profile;
+   int nlpcands, found;
 
    assert(result != NULL);
    //   assert(SCIPhasCurrentNodeLP(scip));
@@ -342,7 +659,11 @@ SCIP_DECL_HEUREXEC(heurExecAleatoria)
      return SCIP_OKAY;
 
    /* solve aleatoria */
-   if(aleatoria(scip, &sol, heur)){
+   profile = SCIPprobdataGetProfile(SCIPgetProbData(scip), PROFILE_ALEATORIA);
+   profileCallStart(profile);
+   found = aleatoria(scip, &sol, heur);
+   profileCallEnd(profile);
+   if(found){
      *result = SCIP_FOUNDSOL;
    }
    else{
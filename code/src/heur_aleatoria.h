@@ -29,6 +29,11 @@
 
 #include "scip/scip.h"
 
+/* construction modes of the aleatoria heuristic (--aleatoria_mode) */
+#define ALEATORIA_RANDOM      0 /**< items selected uniformly at random */
+#define ALEATORIA_GRASP       1 /**< greedy randomized construction plus local search */
+#define ALEATORIA_LP          2 /**< items sampled with probability proportional to their LP values */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -0,0 +1,325 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_lb.c
+ * @brief  local branching primal heuristic
+ *
+ * The sub-SCIP is the original model plus the local branching constraint
+ *    sum_{i: x*_i=0} x_i + sum_{i: x*_i=1} (1 - x_i) <= r,
+ * where x* is the incumbent, so moves that swap a heavy item by several light ones are inside the neighborhood. The
+ * radius r starts with --lb_radius and it is adapted as in Fischetti and Lodi: it is increased when the sub-SCIP proves
+ * that the neighborhood has no better solution, it is decreased when the sub-SCIP stops by time limit without an
+ * improving solution, and it is kept when an improving solution is found (the next neighborhood is centered on it).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "utils.h"
+#include "heur_lb.h"
+
+//#define DEBUG_LB 1
+/* configuracao da heuristica */
+#define HEUR_NAME             "lb"
+#define HEUR_DESC             "local branching primal heuristic"
+#define HEUR_DISPCHAR         'B'
+#define HEUR_PRIORITY         1 /**< heuristics of high priorities are called first */
+#define HEUR_FREQ             1 /**< heuristic call frequency. 1 = in all levels of the B&B tree */
+#define HEUR_FREQOFS          0 /**< starts of level 0 (root node) */
+#define HEUR_MAXDEPTH         -1 /**< maximal level to be called. -1 = no limit */
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
+#define HEUR_USESSUBSCIP      TRUE  /**< does the heuristic use a secondary SCIP instance? */
+
+#define LB_MINRADIUS          2 /**< below this radius the neighborhood is too small to use a sub-SCIP */
+
+#ifdef DEBUG
+   #define PRINTF(...) printf(__VA_ARGS__)
+#else
+   #define PRINTF(...) 
+#endif
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   int                   radius;             /**< current radius of the neighborhood */
+   SCIP_Real             lastincumbent;      /**< value of the incumbent in the last run */
+   int                   lastradius;         /**< radius used in the last run */
+};
+
+/** data of the local branching constraint */
+typedef struct{
+   int*                  xinc;               /**< xinc[i]=1 if item i is in the incumbent */
+   int                   radius;             /**< maximum of items that can change */
+} lbConsDataT;
+
+/*
+ * Local methods
+ */
+
+/** adds the local branching constraint to the sub-SCIP (extra constraint callback of SCIPprobdataCreate) */
+static
+SCIP_RETCODE addLocalBranchingCons(SCIP* scip, SCIP_VAR** vars, instanceT* I, void* data)
+{
+   lbConsDataT* lbdata;
+   SCIP_CONS* cons;
+   int i, ones;
+
+   lbdata = (lbConsDataT*) data;
+   ones = 0;
+   SCIP_CALL( SCIPcreateConsBasicLinear(scip, &cons, "localbranching", 0, NULL, NULL, -SCIPinfinity(scip), 0.0) );
+   for(i=0;i<I->n;i++){
+      if(lbdata->xinc[i]){
+         SCIP_CALL( SCIPaddCoefLinear(scip, cons, vars[i], -1.0) );
+         ones++;
+      }
+      else{
+         SCIP_CALL( SCIPaddCoefLinear(scip, cons, vars[i], 1.0) );
+      }
+   }
+   SCIP_CALL( SCIPchgRhsLinear(scip, cons, (double) (lbdata->radius - ones)) );
+   SCIP_CALL( SCIPaddCons(scip, cons) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** copy method for primal heuristic plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_HEURCOPY(heurCopyLb)
+{  /*lint --e{715}*/
+   parametersT param;
+
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* the copy starts with the current radius of the neighborhood */
+   param.lb_radius = SCIPheurGetData(heur)->radius;
+   SCIP_CALL( SCIPincludeHeurLb(scip, &param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeLb)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolLb)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   const parametersT* param;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   param = SCIPprobdataGetParam(SCIPgetProbData(scip));
+   heurdata->radius = param->lb_radius;
+   heurdata->lastincumbent = -SCIPinfinity(scip);
+   heurdata->lastradius = -1;
+
+   return SCIP_OKAY;
+}
+
+
+/**
+ * @brief Core of the local branching heuristic: it solves the neighborhood of radius r of the incumbent and adapts r.
+ *
+ * @param scip problem
+ * @param initsol incumbent solution
+ * @param heur pointer to the local branching heuristic handle (to contabilize statistics)
+ * @return int 1 if solutions is found, 0 if not found, -1 if the neighborhood was not explored.
+ */
+int localBranching(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
+{
+   parametersT lbparam;
+   const parametersT* param;
+   SCIP_HEURDATA* heurdata;
+   SCIP* subscip;
+   SCIP_PROBDATA* probdata, *probdata2;
+   SCIP_VAR **vars, **vars2;
+   SCIP_SOL *lbSol, *sol;
+   SCIP_STATUS status;
+   lbConsDataT lbdata;
+   instanceT* I;
+   unsigned int stored;
+   int i, found, improved, *x;
+
+   found = 0;
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   param = SCIPprobdataGetParam(probdata);
+
+   // the radius covers all the items: the sub-SCIP would be the original problem
+   if(heurdata->radius >= I->n)
+      heurdata->radius = I->n - 1;
+   // this neighborhood was already explored
+   if(heurdata->radius < LB_MINRADIUS ||
+      (heurdata->radius == heurdata->lastradius && SCIPisEQ(scip, heurdata->lastincumbent, SCIPgetPrimalbound(scip))))
+      return -1;
+   heurdata->lastradius = heurdata->radius;
+   heurdata->lastincumbent = SCIPgetPrimalbound(scip);
+
+   x = (int*)malloc(sizeof(int)*I->n);
+   for(i=0;i<I->n;i++)
+      x[i] = SCIPgetSolVal(scip, initsol, vars[i]) > 0.5 ? 1 : 0;
+   lbdata.xinc = x;
+   lbdata.radius = heurdata->radius;
+#ifdef DEBUG_LB
+   printf("\n============== New local branching heur at node: %lld, radius=%d\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)), heurdata->radius);
+#endif
+
+   // create scip and set scip configurations
+   configSubscipParam(&lbparam, param->lb_time);
+   configScip(&subscip, &lbparam);
+   /* disable output to console */
+   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+   // load problem into scip, with the local branching constraint
+   if(!loadProblemExtra(subscip, "lb", I, 0, NULL, &lbparam, addLocalBranchingCons, &lbdata)){
+      printf("\nProblem to load instance problem\n");
+      SCIP_CALL( SCIPfree(&subscip) );
+      free(x);
+      return -1;
+   }
+   /* only solutions better than the incumbent are interesting */
+   SCIP_CALL( SCIPsetObjlimit(subscip, SCIPgetPrimalbound(scip)) );
+   SCIP_CALL( SCIPsolve(subscip) );
+   status = SCIPgetStatus(subscip);
+
+   improved = 0;
+   if(SCIPgetNSols(subscip) > 0 && SCIPgetPrimalbound(subscip) > SCIPgetPrimalbound(scip) + EPSILON){
+      probdata2 = SCIPgetProbData(subscip);
+      assert(probdata2 != NULL);
+      vars2 = SCIPprobdataGetVars(probdata2);
+      lbSol = SCIPgetBestSol(subscip);
+      for(i=0;i<I->n;i++)
+         x[i] = SCIPgetSolVal(subscip, lbSol, vars2[i]) > 0.5 ? 1 : 0;
+      improved = 1;
+   }
+   SCIP_CALL( SCIPfree(&subscip) );
+
+   if(improved){
+      SCIP_CALL( createSolFromItems(scip, heur, x, &sol) );
+      SCIP_CALL( SCIPtrySolMine(scip, sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      SCIP_CALL( SCIPfreeSol(scip, &sol) );
+      found = stored ? 1 : 0;
+   }
+   // adapt the radius
+   else if(status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE){
+      // no better solution in the neighborhood: enlarge it
+      heurdata->radius += heurdata->radius/2 > 0 ? heurdata->radius/2 : 1;
+   }
+   else{
+      // the neighborhood is too large to be explored in lb_time: shrink it
+      heurdata->radius -= heurdata->radius/2;
+   }
+#ifdef DEBUG_LB
+   printf("\nLocal branching: status=%d found=%d new radius=%d\n", status, found, heurdata->radius);
+#endif
+   free(x);
+   return found;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecLb)
+{  /*lint --e{715}*/
+   SCIP_SOL*             sol;                /**< incumbent solution */
+   int found;
+
+   assert(result != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   sol = SCIPgetBestSol(scip);
+   if(sol==NULL)
+      return SCIP_OKAY;
+
+   found = localBranching(scip, sol, heur);
+   if(found < 0)
+      return SCIP_OKAY;
+   if(found){
+     *result = SCIP_FOUNDSOL;
+   }
+   else{
+     *result = SCIP_DIDNOTFIND;
+#ifdef DEBUG_PRIMAL
+     printf("\nLocal branching could not find better solution!");
+#endif
+   }
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the local branching primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurLb(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create local branching primal heuristic data */
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+   heurdata->radius = param->lb_radius;
+   heurdata->lastincumbent = -SCIPinfinity(scip);
+   heurdata->lastradius = -1;
+
+   heur = NULL;
+
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur,
+         HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS,
+         HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecLb, heurdata) );
+
+   assert(heur != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetHeurCopy(scip, heur, heurCopyLb) );
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeLb) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolLb) );
+
+   return SCIP_OKAY;
+}
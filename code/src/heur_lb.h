@@ -0,0 +1,48 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_lb.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  local branching primal heuristic
+ *
+ * solves a sub-SCIP with the local branching constraint: at most r item variables can change their values in the
+ * incumbent. The radius r is adapted after each call.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_LB_H__
+#define __SCIP_HEUR_LB_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  
+int localBranching(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur);
+
+/** creates the local branching primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurLb(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
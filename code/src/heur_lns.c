@@ -25,6 +25,7 @@
 #include "probdata_mochila.h"
 #include "parameters_mochila.h"
 #include "utils.h"
+#include "dp_mochila.h"
 #include "heur_lns.h"
 
 //#define DEBUG_LNS 1
@@ -70,6 +71,11 @@
 static
 SCIP_DECL_HEURCOPY(heurCopyLns)
 {  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* call inclusion method of primal heuristic (the parameters are read from the problem data in each call) */
+   SCIP_CALL( SCIPincludeHeurLns(scip, NULL) );
 
    return SCIP_OKAY;
 }
@@ -146,6 +152,9 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
    int *fixed;
    itemType *cand;
    int nCands, capacRes, toRemove, perda, nRemoved;
+   int nFree, dpZ, dpStatus, *x;
+   heurProfileT* profile;
+   double tprof;
 #ifdef DEBUG_LNS
    int infeasible;
    unsigned int status;
@@ -162,6 +171,7 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
    vars = SCIPprobdataGetVars(probdata);
    I = SCIPprobdataGetInstance(probdata);
    param = SCIPprobdataGetParam(probdata);
+   profile = SCIPprobdataGetProfile(probdata, PROFILE_LNS);
    nFixed = 0;
    custo = 0;
    capacRes = I->C;
@@ -225,13 +235,49 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
   printf("\nDestrui %.2lf%% (equivalente a um valor = %d)\n", (100.0*nRemoved/nCands), perda);
 #endif
 
+  z = SCIPsolGetOrigObj(initsol); // objective function for the initial solution 
+  // small neighborhoods are solved by dynamic programming instead of a sub-SCIP
+  if(param->lns_dpmax > 0){
+    // the neighborhood can not improve the initial solution
+    if(dpBound(I, fixed) <= z + EPSILON){
+      free(cand);
+      free(fixed);
+      return 0;
+    }
+    nFree = 0;
+    for(i=0;i<I->n;i++){
+      if(!fixed[i])
+        nFree++;
+    }
+    if(nFree <= param->lns_dpmax){
+      x = (int*)malloc(sizeof(int)*I->n);
+      dpStatus = dpSolve(I, fixed, DP_MAXCELLS, x, &dpZ);
+#ifdef DEBUG_LNS
+      printf("\nDP with %d free items: status=%d z=%d", nFree, dpStatus, dpZ);
+#endif
+      if(dpStatus != 0){ // solved (or infeasible) without the sub-SCIP
+        if(dpStatus == 1 && dpZ > SCIPgetPrimalbound(scip) + EPSILON){
+          tprof = profileStart(profile);
+          SCIP_CALL( createSolFromItems(scip, heur, x, &sol) );
+          profileStop(profile, PROFILE_TRANSFER, tprof);
+          tprof = profileStart(profile);
+          SCIP_CALL( SCIPtrySolMine(scip, sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+          profileStop(profile, PROFILE_TRYSOL, tprof);
+          found = stored ? 1 : 0;
+          SCIP_CALL( SCIPfreeSol(scip, &sol) );
+        }
+        free(x);
+        free(cand);
+        free(fixed);
+        return found;
+      }
+      free(x);
+    }
+  }
+
   // create scip and set scip configurations
-  lnsparam.time_limit = param->lns_time;
-  lnsparam.display_freq = -1;
-  lnsparam.nodes_limit = -1;
-  lnsparam.heur_rf = 0;
-  lnsparam.heur_lns = 0;
-  lnsparam.heur_aleatoria = 0;
+  tprof = profileStart(profile);
+  configSubscipParam(&lnsparam, param->lns_time);
   configScip(&subscip, &lnsparam);
   /* disable output to console */
   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
@@ -246,11 +292,16 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
   assert(probdata2 != NULL);
   // Recupera vars
   vars2 = SCIPprobdataGetVars(probdata2);
+  profileStop(profile, PROFILE_SETUP, tprof);
+#ifdef DEBUG_LNS
   // print problem
   SCIP_CALL( SCIPwriteOrigProblem(subscip, "lns.lp", "lp", FALSE) );
+#endif
      
   // solve scip problem
+  tprof = profileStart(profile);
   SCIP_CALL( SCIPsolve(subscip) );
+  profileStop(profile, PROFILE_SOLVE, tprof);
 #ifdef DEBUG_LNS
   SCIP_CALL( SCIPprintBestSol(subscip, NULL, FALSE) );
 #endif
@@ -263,20 +314,20 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
   // Recupera solucao
   lnsSol = SCIPgetBestSol(subscip);
   lnsZ = SCIPgetPrimalbound(subscip); // o.f. for the solution found by LNS
-  z = SCIPsolGetOrigObj(initsol); // objective function for the initial solution 
   if (lnsZ > z + EPSILON){
 #ifdef DEBUG
      printf("\nSolucao do LNS:");
 #endif
      /* create SCIP solution structure sol */
+     tprof = profileStart(profile);
      SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
      nInSolution = 0;
      for (i = 0; i < I->n; i++)
      {
         valor = SCIPgetSolVal(subscip, lnsSol, vars2[i]);
         if(valor>EPSILON){
-          // set found solution in sol (for original problem)
-          SCIP_CALL( SCIPsetSolVal(scip, sol, vars[i], 1.0) );
+          // set found solution in sol (for original problem): copies of merged items, if any
+          SCIP_CALL( SCIPsetSolVal(scip, sol, vars[i], SCIPfeasRound(subscip, valor)) );
 #ifdef DEBUG
           printf("\nItem %d (peso=%d valor=%d)", I->item[i].label, I->item[i].weight, I->item[i].value);
 #endif
@@ -290,6 +341,7 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
            SCIP_CALL( SCIPsetSolVal(scip, sol, vars[I->n+i], valor) );
         }
      }
+     profileStop(profile, PROFILE_TRANSFER, tprof);
      // check if the solution found by LNS is better than the current bestsolution
      bestUb = SCIPgetPrimalbound(scip);
 #ifdef DEBUG_LNS
@@ -303,7 +355,9 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
       SCIP_CALL( SCIPprintSol(scip, sol, NULL, FALSE) );
 #endif
       /* check if the solution is feasible */
+      tprof = profileStart(profile);
       SCIP_CALL( SCIPtrySolMine(scip, sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      profileStop(profile, PROFILE_TRYSOL, tprof);
       if( stored )
       {
 #ifdef DEBUG_PRIMAL
@@ -324,7 +378,9 @@ int lns(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
   free(cand);
   free(fixed);
   // clear problem
+  tprof = profileStart(profile);
   SCIP_CALL( SCIPfree(&subscip) );
+  profileStop(profile, PROFILE_SETUP, tprof);
   return found;
 }
 
@@ -333,7 +389,8 @@ static
 SCIP_DECL_HEUREXEC(heurExecLns)
 {  /*lint --e{715}*/
    SCIP_SOL*             sol;                /**< solution to improve */
-   int nlpcands;   
+   heurProfileT*         profile;
+   int nlpcands, found;
 
    assert(result != NULL);
    //   assert(SCIPhasCurrentNodeLP(scip));
@@ -361,7 +418,11 @@ SCIP_DECL_HEUREXEC(heurExecLns)
    if(sol==NULL)
       return SCIP_OKAY;
    /* solve lns */
-   if(lns(scip, sol, heur)){
+   profile = SCIPprobdataGetProfile(SCIPgetProbData(scip), PROFILE_LNS);
+   profileCallStart(profile);
+   found = lns(scip, sol, heur);
+   profileCallEnd(profile);
+   if(found){
      *result = SCIP_FOUNDSOL;
    }
    else{
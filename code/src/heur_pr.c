@@ -0,0 +1,298 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_pr.c
+ * @brief  pr (path relinking) primal heuristic
+ *
+ * Each call takes one pair of solutions (A,B) of the elite pool and walks from A to B and from B to A. In each step,
+ * one of the items where the current solution differs from the guiding one is flipped: the move with the best change in
+ * the objective value (evaluated incrementally over the forfeit sets of the item) that keeps the solution feasible.
+ * Every intermediate solution better than the incumbent is submitted to SCIP.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "utils.h"
+#include "solstate.h"
+#include "event_elitepool.h"
+#include "heur_pr.h"
+
+//#define DEBUG_PR 1
+/* configuracao da heuristica */
+#define HEUR_NAME             "pr"
+#define HEUR_DESC             "path relinking over the elite pool"
+#define HEUR_DISPCHAR         'p'
+#define HEUR_PRIORITY         1 /**< heuristics of high priorities are called first */
+#define HEUR_FREQ             1 /**< heuristic call frequency. 1 = in all levels of the B&B tree */
+#define HEUR_FREQOFS          0 /**< starts of level 0 (root node) */
+#define HEUR_MAXDEPTH         -1 /**< maximal level to be called. -1 = no limit */
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
+#define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
+
+#ifdef DEBUG
+   #define PRINTF(...) printf(__VA_ARGS__)
+#else
+   #define PRINTF(...) 
+#endif
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   int                   lastversion;        /**< version of the elite pool in the last call */
+   int                   pair;               /**< next pair of the elite pool to be relinked */
+};
+
+/*
+ * Local methods
+ */
+
+/**
+ * @brief walks from xinit to xguide and submits the intermediate solutions better than the incumbent.
+ *
+ * @return int 1 if some solution was stored, 0 otherwise.
+ */
+static
+int relink(SCIP* scip, SCIP_HEUR* heur, instanceT* I, int* xinit, int* xguide)
+{
+   solstateT* S;
+   SCIP_SOL* sol;
+   unsigned int stored;
+   int i, k, found, ndiff, bestk, delta, bestdelta, *diff;
+
+   found = 0;
+   solstateCreate(&S, I);
+   solstateLoad(S, xinit);
+   diff = (int*) malloc(sizeof(int)*I->n);
+   ndiff = 0;
+   for(i=0;i<I->n;i++){
+      if(xinit[i] != xguide[i])
+         diff[ndiff++] = i;
+   }
+   // the last move would reach the guiding solution
+   while(ndiff > 1){
+      bestk = -1;
+      bestdelta = INT_MIN;
+      for(k=0;k<ndiff;k++){
+         i = diff[k];
+         if(S->x[i]){
+            delta = solstateDeltaRemove(S, i, NULL);
+         }
+         else{
+            if(!solstateCanAdd(S, i))
+               continue;
+            delta = solstateDeltaAdd(S, i, NULL);
+         }
+         if(delta > bestdelta){
+            bestdelta = delta;
+            bestk = k;
+         }
+      }
+      if(bestk < 0)
+         break;
+      i = diff[bestk];
+      if(S->x[i])
+         solstateRemove(S, i);
+      else
+         solstateAdd(S, i);
+      diff[bestk] = diff[--ndiff];
+#ifdef DEBUG_PR
+      printf("\nflip item %d delta=%d value=%d weight=%d violations=%d (%d to go)", i, bestdelta, S->value, S->weight, S->violations, ndiff);
+#endif
+      if(solstateFeasible(S) && S->value > SCIPgetPrimalbound(scip) + EPSILON){
+         SCIP_CALL( createSolFromItems(scip, heur, S->x, &sol) );
+         SCIP_CALL( SCIPtrySolMine(scip, sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+         SCIP_CALL( SCIPfreeSol(scip, &sol) );
+         if(stored){
+#ifdef DEBUG_PR
+            printf("\nPath relinking found better solution: %d", S->value);
+#endif
+            found = 1;
+         }
+      }
+   }
+   free(diff);
+   solstateFree(&S);
+   return found;
+}
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** copy method for primal heuristic plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_HEURCOPY(heurCopyPr)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* call inclusion method of primal heuristic (the parameters are read from the problem data in each call) */
+   SCIP_CALL( SCIPincludeHeurPr(scip, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreePr)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolPr)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   heurdata->lastversion = -1;
+   heurdata->pair = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/**
+ * @brief Core of the pr heuristic: relinks the next pair of solutions of the elite pool (in both directions).
+ *
+ * @param scip problem
+ * @param heur pointer to the pr heuristic handle (to contabilize statistics)
+ * @return int 1 if solutions is found, 0 if not found, -1 if there is no pair to be relinked.
+ */
+int pr(SCIP* scip, SCIP_HEUR* heur)
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_PROBDATA* probdata;
+   elitePoolT* pool;
+   instanceT* I;
+   int a, b, p, found, *xa, *xb;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   pool = SCIPgetElitePool(scip);
+   if(pool == NULL || pool->nsols < 2)
+      return -1;
+   // a new pool restarts the enumeration of the pairs
+   if(pool->version != heurdata->lastversion){
+      heurdata->lastversion = pool->version;
+      heurdata->pair = 0;
+   }
+   if(heurdata->pair >= pool->nsols*(pool->nsols-1)/2)
+      return -1;
+   // decode the pair (a,b), a < b
+   p = heurdata->pair++;
+   for(a=0;p >= pool->nsols-1-a;a++)
+      p -= pool->nsols-1-a;
+   b = a+1+p;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   I = SCIPprobdataGetInstance(probdata);
+   // copy the pair: the pool changes when new solutions are stored
+   xa = (int*) malloc(sizeof(int)*I->n);
+   xb = (int*) malloc(sizeof(int)*I->n);
+   memcpy(xa, pool->x[a], sizeof(int)*I->n);
+   memcpy(xb, pool->x[b], sizeof(int)*I->n);
+#ifdef DEBUG_PR
+   printf("\n============== Path relinking between %d (value=%d) and %d (value=%d)\n", a, pool->value[a], b, pool->value[b]);
+#endif
+   found = relink(scip, heur, I, xa, xb);
+   found = relink(scip, heur, I, xb, xa) || found;
+   free(xa);
+   free(xb);
+   return found;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecPr)
+{  /*lint --e{715}*/
+   int found;
+
+   assert(result != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   found = pr(scip, heur);
+   if(found < 0)
+      return SCIP_OKAY;
+   if(found){
+     *result = SCIP_FOUNDSOL;
+   }
+   else{
+     *result = SCIP_DIDNOTFIND;
+#ifdef DEBUG_PRIMAL
+     printf("\nPr could not find better solution!");
+#endif
+   }
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the pr primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurPr(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create pr primal heuristic data */
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+   heurdata->lastversion = -1;
+   heurdata->pair = 0;
+
+   heur = NULL;
+
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur,
+         HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS,
+         HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecPr, heurdata) );
+
+   assert(heur != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetHeurCopy(scip, heur, heurCopyPr) );
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreePr) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolPr) );
+
+   return SCIP_OKAY;
+}
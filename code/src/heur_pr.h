@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_pr.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  pr (path relinking) primal heuristic
+ *
+ * walks between pairs of solutions of the elite pool, flipping one differing item at a time
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_PR_H__
+#define __SCIP_HEUR_PR_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  
+int pr(SCIP* scip, SCIP_HEUR* heur);
+
+/** creates the pr primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurPr(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
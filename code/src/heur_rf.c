@@ -69,6 +69,11 @@
 static
 SCIP_DECL_HEURCOPY(heurCopyRf)
 {  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* call inclusion method of primal heuristic (the parameters are read from the problem data in each call) */
+   SCIP_CALL( SCIPincludeHeurRf(scip, NULL) );
 
    return SCIP_OKAY;
 }
@@ -150,6 +155,8 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
 #endif
    itemType *cand;
    int nCand, capacRes;
+   heurProfileT* profile;
+   double tprof;
 #ifdef TESTE
    int ii;
 #endif
@@ -168,6 +175,7 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    I = SCIPprobdataGetInstance(probdata);
    n = I->n;
    param = SCIPprobdataGetParam(probdata);
+   profile = SCIPprobdataGetProfile(probdata, PROFILE_RF);
    
    solution = (SCIP_VAR**) malloc(sizeof(SCIP_VAR*)*n);
    nInSolution = 0;
@@ -215,7 +223,7 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    // particiona as variaveis
    for(parte=0;parte<K;parte++){
      for(i=0;i<tam && nCand>0;i++){
-       k = RandomInteger(0,nCand-1); // sorteia um candidato
+       k = RandomInteger(SCIPprobdataGetRandnumgen(probdata),0,nCand-1); // sorteia um candidato
        particao[cand[k].label] = parte;
        // remove candidato
        cand[k] = cand[--nCand];
@@ -228,15 +236,12 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
    }
 #endif
   // create scip and set scip configurations
-  rfparam.time_limit = param->rf_time;
-  rfparam.display_freq = -1;
-  rfparam.nodes_limit = -1;
-  rfparam.heur_rf = 0;
-  rfparam.heur_lns = 0;
-  rfparam.heur_aleatoria = 0;
+  tprof = profileStart(profile);
+  configSubscipParam(&rfparam, param->rf_time);
   configScip(&subscip, &rfparam);
   /* disable output to console */
   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+  profileStop(profile, PROFILE_SETUP, tprof);
   frac = 1;
   for(parte=0;parte<K && frac && !infeasible && nFixed < I->n;parte++){ // itera para cada parte da particao, mas pode parar antes se a solucao ja eh inteira.
 #ifdef DEBUG_RF
@@ -244,6 +249,7 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
 #endif
     // carga do lp
     // load problem into scip
+    tprof = profileStart(profile);
     if(!loadProblem(subscip, "rf", I, 1, fixed, &rfparam)){ // relaxation
       printf("\nProblem to load instance problem\n");
       return 0;
@@ -259,13 +265,16 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
         SCIPchgVarType(subscip, vars2[i], SCIP_VARTYPE_BINARY, &infeasible);
       }
     }
+    profileStop(profile, PROFILE_SETUP, tprof);
 #ifdef DEBUG_RF
     // print problem
     printf("\n---LP gravado em relax_fix.lp");
     SCIP_CALL( SCIPwriteOrigProblem(subscip, "relaxFix.lp", "lp", FALSE) );
 #endif
     // Executa Solver de PL
+    tprof = profileStart(profile);
     SCIP_CALL( SCIPsolve(subscip) );
+    profileStop(profile, PROFILE_SOLVE, tprof);
   
 #ifdef DEBUG_RF
     status = SCIPgetStatus(subscip);
@@ -335,6 +344,7 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
   if(!infeasible){
     //    SCIP_CALL( SCIPprintSol(subscip, bestSolution, NULL, FALSE) );
     /* create SCIP solution structure sol */
+    tprof = profileStart(profile);
     SCIP_CALL( SCIPcreateSol(scip, sol, heur) );
     // save found solution in sol
     for(i=0;i<nInSolution;i++){
@@ -348,6 +358,7 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
         SCIP_CALL( SCIPsetSolVal(scip, *sol, vars[I->n+i], valor) );
       }
     }
+    profileStop(profile, PROFILE_TRANSFER, tprof);
     bestUb = SCIPgetPrimalbound(scip);
 #ifdef DEBUG_RF
     printf("\nFound solution...\n");
@@ -360,7 +371,9 @@ int rf(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
       SCIP_CALL( SCIPprintSol(scip, *sol, NULL, FALSE) );
 #endif
       /* check if the solution is feasible */
+      tprof = profileStart(profile);
       SCIP_CALL( SCIPtrySolMine(scip, *sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      profileStop(profile, PROFILE_TRYSOL, tprof);
       if( stored )
       {
 #ifdef DEBUG_PRIMAL
@@ -394,7 +407,8 @@ static
 SCIP_DECL_HEUREXEC(heurExecRf)
 {  /*lint --e{715}*/
    SCIP_SOL*             sol;                /**< solution to round */
-   int nlpcands;
+   heurProfileT*         profile;
+   int nlpcands, found;
 
    assert(result != NULL);
    //   assert(SCIPhasCurrentNodeLP(scip));
@@ -419,7 +433,11 @@ SCIP_DECL_HEUREXEC(heurExecRf)
      return SCIP_OKAY;
 
    /* solve rf */
-   if(rf(scip, &sol, heur)){
+   profile = SCIPprobdataGetProfile(SCIPgetProbData(scip), PROFILE_RF);
+   profileCallStart(profile);
+   found = rf(scip, &sol, heur);
+   profileCallEnd(profile);
+   if(found){
      *result = SCIP_FOUNDSOL;
    }
    else{
@@ -0,0 +1,349 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_rins.c
+ * @brief  rins (relaxation induced neighborhood search) primal heuristic
+ *
+ * The item variables where the incumbent and the LP solution of the current node agree are fixed, as well as the item
+ * variables where the best --rins_poolsols solutions of the elite pool agree (crossover). The remaining items are
+ * solved by a sub-SCIP (or by dynamic programming, when there are at most --lns_dpmax free items).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "utils.h"
+#include "dp_mochila.h"
+#include "event_elitepool.h"
+#include "heur_rins.h"
+
+//#define DEBUG_RINS 1
+/* configuracao da heuristica */
+#define HEUR_NAME             "rins"
+#define HEUR_DESC             "relaxation induced neighborhood search with crossover over the elite pool"
+#define HEUR_DISPCHAR         'N'
+#define HEUR_PRIORITY         1 /**< heuristics of high priorities are called first */
+#define HEUR_FREQ             1 /**< heuristic call frequency. 1 = in all levels of the B&B tree */
+#define HEUR_FREQOFS          0 /**< starts of level 0 (root node) */
+#define HEUR_MAXDEPTH         -1 /**< maximal level to be called. -1 = no limit */
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
+#define HEUR_USESSUBSCIP      TRUE  /**< does the heuristic use a secondary SCIP instance? */
+
+#ifdef DEBUG
+   #define PRINTF(...) printf(__VA_ARGS__)
+#else
+   #define PRINTF(...) 
+#endif
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   SCIP_Real             lastincumbent;      /**< value of the incumbent in the last run */
+   int                   lastnfree;          /**< total of free items in the last run */
+};
+
+/*
+ * Local methods
+ */
+
+/** marks in agree[] the items where the best nsols solutions of the pool agree (-1 if they disagree) */
+static
+int poolAgreement(elitePoolT* pool, int nsols, int* agree)
+{
+   int i, s, t, *best;
+
+   if(pool == NULL || nsols < 2 || pool->nsols < nsols)
+      return 0;
+   // select the best nsols solutions of the pool
+   best = (int*) malloc(sizeof(int)*pool->nsols);
+   for(s=0;s<pool->nsols;s++)
+      best[s] = s;
+   for(s=0;s<nsols;s++){
+      for(t=s+1;t<pool->nsols;t++){
+         if(pool->value[best[t]] > pool->value[best[s]]){
+            i = best[s]; best[s] = best[t]; best[t] = i;
+         }
+      }
+   }
+   for(i=0;i<pool->n;i++){
+      agree[i] = pool->x[best[0]][i];
+      for(s=1;s<nsols && agree[i] >= 0;s++){
+         if(pool->x[best[s]][i] != agree[i])
+            agree[i] = -1;
+      }
+   }
+   free(best);
+   return 1;
+}
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** copy method for primal heuristic plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_HEURCOPY(heurCopyRins)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(heur != NULL);
+
+   /* call inclusion method of primal heuristic (the parameters are read from the problem data in each call) */
+   SCIP_CALL( SCIPincludeHeurRins(scip, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeRins)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolRins)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   heurdata->lastincumbent = -SCIPinfinity(scip);
+   heurdata->lastnfree = -1;
+
+   return SCIP_OKAY;
+}
+
+
+/**
+ * @brief Core of the rins heuristic: it fixes the items where the incumbent agrees with the LP (or with the pool)
+ * and solves the remaining problem.
+ *
+ * @param scip problem
+ * @param initsol incumbent solution
+ * @param heur pointer to the rins heuristic handle (to contabilize statistics)
+ * @return int 1 if solutions is found, 0 if not found, -1 if the neighborhood was not explored.
+ */
+int rins(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur)
+{
+   parametersT rinsparam;
+   const parametersT* param;
+   SCIP_HEURDATA* heurdata;
+   SCIP* subscip;
+   SCIP_PROBDATA* probdata, *probdata2;
+   SCIP_VAR **vars, **vars2;
+   SCIP_SOL *rinsSol, *sol;
+   SCIP_Real lpval;
+   instanceT* I;
+   unsigned int stored;
+   int i, inc, found, nFree, nFixedLp, nFixedPool, usePool, dpStatus, dpZ;
+   int *fixed, *agree, *x;
+
+   found = 0;
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   param = SCIPprobdataGetParam(probdata);
+
+   fixed = (int*)calloc(I->n, sizeof(int)); // fixed[i]=0, if item i is not fixed, fixed[i]=1 if item i is fixed in 1.0, fixed[i]=-1 if item i is fixed in 0.
+   agree = (int*)malloc(sizeof(int)*I->n);
+   usePool = poolAgreement(SCIPgetElitePool(scip), param->rins_poolsols, agree);
+   nFree = 0;
+   nFixedLp = 0;
+   nFixedPool = 0;
+   for(i=0;i<I->n;i++){
+      inc = SCIPgetSolVal(scip, initsol, vars[i]) > 0.5 ? 1 : 0;
+      lpval = SCIPgetSolVal(scip, NULL, vars[i]); // value in the LP solution of the current node
+      if(SCIPvarGetLbLocal(vars[i]) > 1.0 - EPSILON){ // fixed by branching
+         fixed[i] = 1;
+      }
+      else if(SCIPvarGetUbLocal(vars[i]) < EPSILON){
+         fixed[i] = -1;
+      }
+      else if(fabs(lpval - inc) < EPSILON){ // incumbent and LP agree
+         fixed[i] = inc ? 1 : -1;
+         nFixedLp++;
+      }
+      else if(usePool && agree[i] == inc){ // the elite solutions agree
+         fixed[i] = inc ? 1 : -1;
+         nFixedPool++;
+      }
+      else{
+         nFree++;
+      }
+   }
+   free(agree);
+#ifdef DEBUG_RINS
+   printf("\n============== New rins heur at node: %lld: %d fixed by LP, %d fixed by pool, %d free\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)), nFixedLp, nFixedPool, nFree);
+#endif
+   // the neighborhood is too large, or it is the same of the last run
+   if(nFree == 0 || nFree > (1.0 - param->rins_minfix)*I->n ||
+      (nFree == heurdata->lastnfree && SCIPisEQ(scip, heurdata->lastincumbent, SCIPgetPrimalbound(scip)))){
+      free(fixed);
+      return -1;
+   }
+   heurdata->lastnfree = nFree;
+   heurdata->lastincumbent = SCIPgetPrimalbound(scip);
+
+   x = (int*)malloc(sizeof(int)*I->n);
+   // small neighborhoods are solved by dynamic programming
+   dpStatus = 0;
+   if(nFree <= param->lns_dpmax){
+      dpStatus = dpSolve(I, fixed, DP_MAXCELLS, x, &dpZ);
+      if(dpStatus == 1 && dpZ <= SCIPgetPrimalbound(scip) + EPSILON)
+         dpStatus = -1; // no improvement
+   }
+   if(dpStatus == 0){
+      // create scip and set scip configurations
+      configSubscipParam(&rinsparam, param->rins_time);
+      configScip(&subscip, &rinsparam);
+      /* disable output to console */
+      SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+      // load problem into scip
+      if(!loadProblem(subscip, "rins", I, 0, fixed, &rinsparam)){
+         printf("\nProblem to load instance problem\n");
+         SCIP_CALL( SCIPfree(&subscip) );
+         free(x);
+         free(fixed);
+         return -1;
+      }
+      /* only solutions better than the incumbent are interesting */
+      SCIP_CALL( SCIPsetObjlimit(subscip, SCIPgetPrimalbound(scip)) );
+      SCIP_CALL( SCIPsolve(subscip) );
+
+      if(SCIPgetNSols(subscip) > 0 && SCIPgetPrimalbound(subscip) > SCIPgetPrimalbound(scip) + EPSILON){
+         probdata2 = SCIPgetProbData(subscip);
+         assert(probdata2 != NULL);
+         vars2 = SCIPprobdataGetVars(probdata2);
+         rinsSol = SCIPgetBestSol(subscip);
+         for(i=0;i<I->n;i++)
+            x[i] = SCIPgetSolVal(subscip, rinsSol, vars2[i]) > 0.5 ? 1 : 0;
+         dpStatus = 1;
+      }
+      SCIP_CALL( SCIPfree(&subscip) );
+   }
+   if(dpStatus == 1){
+      SCIP_CALL( createSolFromItems(scip, heur, x, &sol) );
+      SCIP_CALL( SCIPtrySolMine(scip, sol, TRUE, TRUE, FALSE, TRUE, &stored) );
+      SCIP_CALL( SCIPfreeSol(scip, &sol) );
+      found = stored ? 1 : 0;
+#ifdef DEBUG_RINS
+      printf("\nRins solution stored=%d\n", found);
+#endif
+   }
+   free(x);
+   free(fixed);
+   return found;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecRins)
+{  /*lint --e{715}*/
+   SCIP_SOL*             sol;                /**< incumbent solution */
+   int nlpcands, found;
+
+   assert(result != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   /* continue only if the LP is finished */
+   if ( SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL )
+      return SCIP_OKAY;
+
+   /* continue only if the LP value is less than the cutoff bound */
+   if( SCIPisGE(scip, SCIPgetLPObjval(scip), SCIPgetCutoffbound(scip)) )
+      return SCIP_OKAY;
+
+   /* check if there exists integer variables with fractionary values in the LP */
+   SCIP_CALL( SCIPgetLPBranchCands(scip, NULL, NULL, NULL, &nlpcands, NULL, NULL) );
+
+   /* stop if the LP solution is already integer   */
+   if ( nlpcands == 0 )
+     return SCIP_OKAY;
+
+   sol = SCIPgetBestSol(scip);
+   if(sol==NULL)
+      return SCIP_OKAY;
+
+   found = rins(scip, sol, heur);
+   if(found < 0)
+      return SCIP_OKAY;
+   if(found){
+     *result = SCIP_FOUNDSOL;
+   }
+   else{
+     *result = SCIP_DIDNOTFIND;
+#ifdef DEBUG_PRIMAL
+     printf("\nRins could not find better solution!");
+#endif
+   }
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the rins primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurRins(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create rins primal heuristic data */
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+   heurdata->lastincumbent = -SCIPinfinity(scip);
+   heurdata->lastnfree = -1;
+
+   heur = NULL;
+
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur,
+         HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS,
+         HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecRins, heurdata) );
+
+   assert(heur != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetHeurCopy(scip, heur, heurCopyRins) );
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeRins) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolRins) );
+
+   return SCIP_OKAY;
+}
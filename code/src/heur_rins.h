@@ -0,0 +1,48 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_rins.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  rins (relaxation induced neighborhood search) primal heuristic
+ *
+ * fixes the items where the incumbent agrees with the LP solution (or where the solutions of the elite pool agree)
+ * and solves the remaining items with a sub-SCIP
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_RINS_H__
+#define __SCIP_HEUR_RINS_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  
+int rins(SCIP* scip, SCIP_SOL* initsol, SCIP_HEUR* heur);
+
+/** creates the rins primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurRins(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
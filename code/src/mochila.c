@@ -0,0 +1,155 @@
+/**@file   mochila.c
+ * @brief  reentrant library interface: solves one instance of the knapsack problem with forfeit sets
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include "mochila.h"
+#include "utils.h"
+#include "run_mochila.h"
+#include "presolve_mochila.h"
+#include "core_mochila.h"
+
+void mochilaDefaultParameters(parametersT* param)
+{
+   defaultParameters(param);
+}
+
+// copy of the instance reduced by the presolve and by the symmetry (if no option assumes binary items), as in the
+// command line program
+static instanceT* prepareInstance(instanceT* I, const parametersT* param)
+{
+   instanceT* in, *reduced;
+   presolveStatsT pstats;
+
+   copyInstance(I, &in);
+   if(param->presolve){
+      (void) presolveInstance(in, &reduced, &pstats, !param->core);
+      freeInstance(in);
+      in = reduced;
+   }
+   if(param->symmetry && symmetryConflict(param) == NULL){
+      (void) compressInstance(in, &reduced);
+      freeInstance(in);
+      in = reduced;
+   }
+   return in;
+}
+
+// limits of configScip() that may change from one solve to the next one in the same SCIP
+static SCIP_RETCODE setLimits(SCIP* scip, const parametersT* param)
+{
+   SCIP_CALL( SCIPsetIntParam(scip, "display/freq", param->display_freq) );
+   SCIP_CALL( SCIPsetRealParam(scip, "limits/time", param->time_limit) );
+   SCIP_CALL( SCIPsetLongintParam(scip, "limits/nodes", param->nodes_limit) );
+   if(param->threads > 1){
+      SCIP_CALL( SCIPsetIntParam(scip, "parallel/minnthreads", param->threads) );
+      SCIP_CALL( SCIPsetIntParam(scip, "parallel/maxnthreads", param->threads) );
+   }
+   return SCIP_OKAY;
+}
+
+// fills the result with the statistics and the best solution of the solved problem
+static void getResult(SCIP* scip, int n, mochilaResultT* result)
+{
+   SCIP_SOL* sol;
+   SCIP_VAR** vars;
+   instanceT* J;
+   int i, c, copies;
+
+   result->status = SCIPgetStatus(scip);
+   result->primal = SCIPgetPrimalbound(scip);
+   result->dual = SCIPgetDualbound(scip);
+   result->gap = SCIPgetGap(scip);
+   result->nodes = SCIPgetNTotalNodes(scip);
+   sol = SCIPgetBestSol(scip);
+   if(sol != NULL){
+      // the model of the core mode has only the items of the last core
+      J = SCIPprobdataGetInstance(SCIPgetProbData(scip));
+      vars = SCIPprobdataGetVars(SCIPgetProbData(scip));
+      result->items = (int*) malloc(sizeof(int)*(n+1));
+      for(i=0;i<J->n;i++){
+         copies = (int) (SCIPgetSolVal(scip, sol, vars[i]) + 0.5);
+         for(c=0;c<copies;c++)
+            result->items[result->nitems++] = J->item[i].labels != NULL ? J->item[i].labels[c] : J->item[i].label;
+      }
+   }
+}
+
+SCIP_RETCODE mochilaSolve(instanceT* I, const parametersT* param, mochilaResultT* result)
+{
+   SCIP* scip;
+   instanceT* in;
+   parametersT local;
+   SCIP_RETCODE retcode;
+   double start;
+
+   memset(result, 0, sizeof(mochilaResultT));
+   result->status = SCIP_STATUS_UNKNOWN;
+   // the plugins keep pointers to the parameters and to the instance: both are local to this solve
+   local = *param;
+   local.reopt_file = local.sweep_file = local.portfolio_file = NULL;
+   if(!local.core){
+      SCIP_CALL( configScip(&scip, &local) );
+      SCIPsetMessagehdlrQuiet(scip, TRUE);
+      retcode = mochilaSolveIn(scip, I, &local, result);
+      SCIP_CALL( SCIPfree(&scip) );
+      return retcode;
+   }
+   in = prepareInstance(I, &local);
+   start = wallTime();
+   SCIP_CALL( coreSolve(&scip, "mochila", in, &local, 1) );
+   result->time = wallTime() - start;
+   getResult(scip, I->n, result);
+   SCIP_CALL( SCIPfree(&scip) );
+   freeInstance(in);
+   return SCIP_OKAY;
+}
+
+SCIP_RETCODE mochilaSolveIn(SCIP* scip, instanceT* I, parametersT* param, mochilaResultT* result)
+{
+   instanceT* in;
+   double start;
+
+   memset(result, 0, sizeof(mochilaResultT));
+   result->status = SCIP_STATUS_UNKNOWN;
+   in = prepareInstance(I, param);
+   SCIP_CALL( setLimits(scip, param) );
+   start = wallTime();
+   if(!loadProblem(scip, "mochila", in, 0, NULL, param)){
+      SCIP_CALL( SCIPfreeProb(scip) );
+      freeInstance(in);
+      return SCIP_ERROR;
+   }
+   if(param->write_lp != NULL){
+      SCIP_CALL( SCIPwriteOrigProblem(scip, param->write_lp, "lp", FALSE) );
+   }
+   if(param->threads > 1){
+      SCIP_CALL( SCIPsolveConcurrent(scip) );
+   }
+   else{
+      SCIP_CALL( SCIPsolve(scip) );
+   }
+   result->time = wallTime() - start;
+   getResult(scip, I->n, result);
+   // only the problem is freed: the plugins stay in scip for the next solve
+   SCIP_CALL( SCIPfreeProb(scip) );
+   freeInstance(in);
+   return SCIP_OKAY;
+}
+
+int mochilaSamePlugins(const parametersT* a, const parametersT* b)
+{
+   return a->cons_forfeit == b->cons_forfeit && a->prop_redcost == b->prop_redcost && a->sepa_forfeit == b->sepa_forfeit
+      && a->branch_forfeit == b->branch_forfeit && a->heur_aleatoria == b->heur_aleatoria && a->heur_rf == b->heur_rf
+      && a->heur_lns == b->heur_lns && a->heur_pr == b->heur_pr && a->heur_rins == b->heur_rins && a->heur_lb == b->heur_lb
+      && (a->pool_size > 0) == (b->pool_size > 0) && a->heur_freq == b->heur_freq && a->heur_freqofs == b->heur_freqofs
+      && a->heur_maxdepth == b->heur_maxdepth;
+}
+
+void mochilaFreeResult(mochilaResultT* result)
+{
+   free(result->items);
+   result->items = NULL;
+   result->nitems = 0;
+}
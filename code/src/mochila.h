@@ -0,0 +1,42 @@
+/**@file   mochila.h
+ * @brief  reentrant library interface: solves one instance of the knapsack problem with forfeit sets
+ *
+ * All the state of a solve is local (SCIP, copies of the instance and of the parameters, random numbers), so several
+ * solves can run at the same time in different threads (SCIP must be built thread-safe). The output of SCIP is turned
+ * off and no file is written, unless param->write_lp is set. The modes driven by files (--reopt, --sweep, --portfolio) are only
+ * available in the command line program.
+ *
+ * Build with "make libmochila" and link with bin/libmochila.a -lscip -lm -lpthread.
+ **/
+#ifndef __MOCHILA__
+#define __MOCHILA__
+#include "scip/scip.h"
+#include "problem.h"
+#include "parameters_mochila.h"
+
+/** result of a solve */
+typedef struct{
+   int status;        /**< SCIP status (SCIP_STATUS_OPTIMAL, SCIP_STATUS_TIMELIMIT, ...) */
+   double primal;     /**< value of the best solution */
+   double dual;       /**< dual bound */
+   double gap;        /**< relative gap */
+   double time;       /**< wall time of the solve (in sec) */
+   long long nodes;   /**< total of B&B nodes */
+   int nitems;        /**< total of items in the best solution */
+   int* items;        /**< labels (0..n-1) of the items in the best solution (NULL if there is no solution) */
+} mochilaResultT;
+
+// sets the default value of all parameters (the same of the command line without options)
+void mochilaDefaultParameters(parametersT* param);
+// solves the instance I with the parameters param. I and param are not changed
+SCIP_RETCODE mochilaSolve(instanceT* I, const parametersT* param, mochilaResultT* result);
+// solves the instance I in scip, created by configScip(&scip, param) (the plugins keep the pointer param). Only the
+// problem is freed at the end, so the same scip solves the next instance without including the plugins again. The
+// limits (time, nodes, display, threads) are taken from param at each call; the other fields must satisfy
+// mochilaSamePlugins() with the parameters of configScip(), but they may be changed in the same struct
+SCIP_RETCODE mochilaSolveIn(SCIP* scip, instanceT* I, parametersT* param, mochilaResultT* result);
+// 1 if the plugins included by configScip() and their settings fixed at inclusion are the same for a and b
+int mochilaSamePlugins(const parametersT* a, const parametersT* b);
+// frees the arrays of the result
+void mochilaFreeResult(mochilaResultT* result);
+#endif
@@ -7,27 +7,91 @@ typedef struct{
    int time_limit; /* limit of execution time (in sec). Default = 1800 (-1: unlimited) */
    int display_freq; /* frequency to display information about B&B enumeration. Default = 50 (-1: never) */
    int nodes_limit; /* limit of nodes to B&B procedure. Default = -1: unlimited (1: onlyrootnode) */
+   int seed; /* seed of the random numbers of the heuristics (-1: taken from the clock) */
+   char* write_lp; /* file to write the model in LP format (NULL: no file) */
+   int sol_stream; /* 1: each improving solution is appended to <output>.stream and rewrites <output>.sol while solving */
+   int timeline; /* 1: record the primal and dual bounds over the time in <output>.timeline (primal integral in the .out) */
+   double timeline_target; /* primal gap to the final primal bound of the time to target */
 
    // parameter stamp
    char* parameter_stamp;
    char* output_path;
 
+   // presolve
+   int presolve; /* 1: remove heavy and dominated items and tighten v_j before creating the model */
+   int symmetry; /* 1: merge identical items in one integer variable */
+
+   // re-optimization
+   char* reopt_file; /* delta file with changes of the instance to solve again (NULL: no re-optimization) */
+   int reopt_scip; /* 1: use SCIP reoptimization when only the objective changes */
+
+   // parametric sweep
+   char* sweep_file; /* file with pairs (C,k) to solve (NULL: no sweep) */
+   int sweep_threads; /* threads solving the points of the sweep */
+
+   // portfolio
+   char* portfolio_file; /* file with the configurations that race on the instance (NULL: no portfolio) */
+
+   // server
+   int server_workers; /* solvers of the server mode (0: one by processor) */
+
+   // parallel branch-and-bound
+   int threads; /* threads of the concurrent solve of SCIP (1: sequential SCIPsolve) */
+
+   // core mode
+   int core; /* 1: solve only a core of items around the break item, widened until the fixings are proven */
+   int core_size; /* initial size of the core window */
+
+   // constraint handler
+   int cons_forfeit; /* 1: propagate the forfeit sets and the limit k with the forfeit constraint handler */
+
+   // propagation
+   int prop_redcost; /* 1: reduced cost fixing of x and v at each node (replaces the generic redcost propagator) */
+
+   // separation
+   int sepa_forfeit; /* 1: separate cover and cardinality cuts */
+   int sepa_maxrounds; /* maximum of separation rounds by node (-1: unlimited) */
+   int sepa_maxcuts; /* maximum of cuts added by round */
+   double sepa_minefficacy; /* minimum efficacy of the cuts */
+
+   // branching
+   int branch_forfeit; /* 1: branch on the total of violations, on v_j and on the counts of the sets before pscost */
+
    // primal heuristic
    int heur_freq;
    int heur_maxdepth;
    int heur_freqofs;
+   int heur_profile; /* 1: time of each phase of each call of aleatoria, rf and lns in <output>.profile */
    int heur_rf;
    double rf_perc;
    int rf_time;
    int heur_lns;
    double lns_perc;
    int lns_time;  
+   int lns_dpmax; /* maximum of free items to solve the lns neighborhood by dynamic programming (0: never) */
 
    int heur_aleatoria;
+   int aleatoria_mode; /* 0: random, 1: GRASP, 2: LP-biased */
+   double grasp_alpha; /* size of the restricted candidate list in GRASP: 0 = greedy, 1 = random */
+   int heur_pr;
+   int heur_rins;
+   double rins_minfix; /* minimum fraction of fixed items to run rins */
+   int rins_time;
+   int rins_poolsols; /* total of elite solutions that must agree to fix an item in rins (0: only the LP) */
+   int heur_lb;
+   int lb_radius; /* initial radius of the local branching neighborhood */
+   int lb_time;
+
+   // elite pool
+   int pool_size; /* maximum of solutions in the elite pool (0: no pool) */
+   int pool_mindist; /* minimum Hamming distance of a new solution to the pool */
 } parametersT;
 
 int setParameters(int argc, char** argv, parametersT* Param);
-
-extern parametersT param;
-extern const char* output_path;
+// set the default value of all parameters (no stamp file is written)
+void defaultParameters(parametersT* param);
+// set the value of one parameter (name as in the command line, value not copied). Returns 0 or an error code
+#define PARAM_INVALID 1
+#define PARAM_OUTOFRANGE 2
+int setParameterValue(parametersT* param, char* name, char* value);
 #endif
@@ -0,0 +1,197 @@
+/**@file   portfolio_mochila.c
+ * @brief  portfolio mode: several configurations race on the same instance, one thread each
+ **/
+#define _POSIX_C_SOURCE 200809L
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<pthread.h>
+#include "portfolio_mochila.h"
+#include "event_portfolio.h"
+#include "batch_mochila.h"
+#include "run_mochila.h"
+#include "utils.h"
+
+//#define DEBUG_PORTFOLIO 1
+
+/** one solver of the portfolio and its result */
+typedef struct{
+   batchConfigT config;
+   instanceT* I;      /**< copy of the instance used by the solver */
+   SCIP* scip;
+   int valid;         /**< 1 if the configuration is valid */
+   int finish;        /**< order of finish (0: first) */
+   double time;       /**< wall time of the solver */
+} portfolioSolverT;
+
+/** data shared by the threads */
+typedef struct{
+   portfolioSolverT* solvers;
+   char* filename;
+   portfolioSlotT slot;
+   int nfinished;
+   pthread_mutex_t lock;
+} portfolioDataT;
+
+/** thread data */
+typedef struct{
+   portfolioDataT* data;
+   int id;
+} portfolioThreadT;
+
+/** reads the lines "config <file>" of the portfolio file. Returns the total of solvers */
+static int readSolvers(char* portfoliofile, portfolioSolverT** solvers)
+{
+   FILE* fin;
+   char key[SCIP_MAXSTRLEN], value[SCIP_MAXSTRLEN];
+   int n;
+
+   fin = fopen(portfoliofile, "r");
+   if(!fin){
+      printf("\nProblem to open portfolio file %s\n", portfoliofile);
+      return 0;
+   }
+   n = 0;
+   *solvers = NULL;
+   while(fscanf(fin, BATCH_WORD " " BATCH_WORD, key, value) == 2){
+      if(strcmp(key, "config")){
+         printf("\nPortfolio: unknown key %s ignored", key);
+         continue;
+      }
+      *solvers = (portfolioSolverT*) realloc(*solvers, sizeof(portfolioSolverT)*(n+1));
+      memset(&(*solvers)[n], 0, sizeof(portfolioSolverT));
+      (*solvers)[n++].config.filename = strdup(value);
+   }
+   fclose(fin);
+   return n;
+}
+
+/** thread: solves the instance with one configuration */
+static void* portfolioThread(void* arg)
+{
+   portfolioThreadT* thread;
+   portfolioDataT* data;
+   portfolioSolverT* solver;
+   SCIP_STATUS status;
+   double start;
+
+   thread = (portfolioThreadT*) arg;
+   data = thread->data;
+   solver = &data->solvers[thread->id];
+   start = wallTime();
+   configScip(&solver->scip, &solver->config.param);
+   SCIPsetMessagehdlrQuiet(solver->scip, TRUE);
+   SCIP_CALL_ABORT( SCIPincludeEventhdlrPortfolio(solver->scip, &data->slot) );
+   if(!loadProblem(solver->scip, data->filename, solver->I, 0, NULL, &solver->config.param)){
+      printf("\nProblem to load instance problem\n");
+      SCIP_CALL_ABORT( SCIPfree(&solver->scip) );
+      return NULL;
+   }
+   SCIP_CALL_ABORT( SCIPsolve(solver->scip) );
+   solver->time = wallTime() - start;
+   // optimal: the best solution of the portfolio is proved (the imported solutions are in this SCIP)
+   status = SCIPgetStatus(solver->scip);
+   if(status == SCIP_STATUS_OPTIMAL)
+      portfolioSlotStop(&data->slot);
+   pthread_mutex_lock(&data->lock);
+   solver->finish = data->nfinished++;
+   pthread_mutex_unlock(&data->lock);
+#ifdef DEBUG_PORTFOLIO
+   printf("\nPortfolio: %s finished (status %d, primal %lf)", solver->config.filename, status, SCIPgetPrimalbound(solver->scip));
+#endif
+   return NULL;
+}
+
+SCIP_RETCODE portfolioSolve(char* program, char* filename, instanceT* I, parametersT* param, char* portfoliofile, char* outputname)
+{
+   portfolioDataT data;
+   portfolioThreadT* threads;
+   pthread_t* ids;
+   portfolioSolverT* winner;
+   FILE* fout;
+   char name[SCIP_MAXSTRLEN];
+   double start, primal, best;
+   int s, nsolvers;
+
+   nsolvers = readSolvers(portfoliofile, &data.solvers);
+   if(nsolvers == 0)
+      return SCIP_READERROR;
+   // the configurations are checked before the race (setParameters() writes the stamp files)
+   for(s=0;s<nsolvers;s++){
+      data.solvers[s].valid = batchLoadConfig(program, filename, &data.solvers[s].config);
+      if(!data.solvers[s].valid){
+         printf("\nPortfolio: configuration %s is invalid, it is skipped", data.solvers[s].config.filename);
+         continue;
+      }
+      // same limits for all solvers; the instance was already reduced by the command line settings
+      data.solvers[s].config.param.time_limit = param->time_limit;
+      data.solvers[s].config.param.nodes_limit = param->nodes_limit;
+      copyInstance(I, &data.solvers[s].I);
+   }
+   data.filename = filename;
+   data.nfinished = 0;
+   portfolioSlotInit(&data.slot, I->n);
+   pthread_mutex_init(&data.lock, NULL);
+   ids = (pthread_t*) malloc(sizeof(pthread_t)*nsolvers);
+   threads = (portfolioThreadT*) malloc(sizeof(portfolioThreadT)*nsolvers);
+   start = wallTime();
+   for(s=0;s<nsolvers;s++){
+      threads[s].data = &data;
+      threads[s].id = s;
+      if(data.solvers[s].valid)
+         pthread_create(&ids[s], NULL, portfolioThread, &threads[s]);
+   }
+   for(s=0;s<nsolvers;s++){
+      if(data.solvers[s].valid)
+         pthread_join(ids[s], NULL);
+   }
+   pthread_mutex_destroy(&data.lock);
+
+   // winner: the best solution; ties are broken by the optimal status and then by the order of finish
+   winner = NULL;
+   best = 0.0;
+   for(s=0;s<nsolvers;s++){
+      if(data.solvers[s].scip == NULL || SCIPgetBestSol(data.solvers[s].scip) == NULL)
+         continue;
+      primal = SCIPgetSolOrigObj(data.solvers[s].scip, SCIPgetBestSol(data.solvers[s].scip));
+      if(winner == NULL || SCIPisGT(data.solvers[s].scip, primal, best)
+         || (SCIPisEQ(data.solvers[s].scip, primal, best) && (SCIPgetStatus(data.solvers[s].scip) == SCIP_STATUS_OPTIMAL) > (SCIPgetStatus(winner->scip) == SCIP_STATUS_OPTIMAL))
+         || (SCIPisEQ(data.solvers[s].scip, primal, best) && SCIPgetStatus(data.solvers[s].scip) == SCIPgetStatus(winner->scip) && data.solvers[s].finish < winner->finish)){
+         winner = &data.solvers[s];
+         best = primal;
+      }
+   }
+   if(winner != NULL){
+      printf("\nPortfolio: %s wins with %lf (%s)\n", winner->config.filename, best, portfolioSlotStopped(&data.slot) ? "optimal" : "best at the limit");
+      printStatistic(winner->scip, wallTime() - start, outputname, NULL);
+      printSol(winner->scip, outputname);
+   }
+   // one line by solver
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s.portfolio", outputname);
+   fout = fopen(name, "w");
+   if(!fout)
+      printf("\nProblem to create file %s\n", name);
+   else{
+      fprintf(fout, "config;winner;status;primal;dual;gap;time;nodes;imported;finish;%s\n", param->parameter_stamp);
+      for(s=0;s<nsolvers;s++){
+         if(data.solvers[s].scip == NULL){
+            fprintf(fout, "%s;0;-1;*;*;*;0;0;0;-1\n", data.solvers[s].config.filename);
+            continue;
+         }
+         fprintf(fout, "%s;%d;%d;%lf;%lf;%lf;%lf;%lld;%lld;%d\n", data.solvers[s].config.filename, &data.solvers[s] == winner, SCIPgetStatus(data.solvers[s].scip), SCIPgetPrimalbound(data.solvers[s].scip), SCIPgetDualbound(data.solvers[s].scip), SCIPgetGap(data.solvers[s].scip), data.solvers[s].time, SCIPgetNTotalNodes(data.solvers[s].scip), SCIPeventhdlrPortfolioGetNImported(data.solvers[s].scip), data.solvers[s].finish);
+      }
+      fclose(fout);
+   }
+   for(s=0;s<nsolvers;s++){
+      if(data.solvers[s].scip != NULL){
+         SCIP_CALL( SCIPfree(&data.solvers[s].scip) );
+      }
+      freeInstance(data.solvers[s].I);
+      batchFreeConfig(&data.solvers[s].config);
+   }
+   portfolioSlotFree(&data.slot);
+   free(threads);
+   free(ids);
+   free(data.solvers);
+   return SCIP_OKAY;
+}
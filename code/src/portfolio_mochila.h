@@ -0,0 +1,19 @@
+/**@file   portfolio_mochila.h
+ * @brief  portfolio mode: several configurations race on the same instance, one thread each
+ *
+ * The portfolio file has one line "config <file>" by solver, where the configuration file has the same options of the
+ * command line. Each solver has its own SCIP and its own copy of the instance, and all of them share the best objective
+ * value (event_portfolio.h), so each solver prunes with the incumbent of the others. The first solver to prove
+ * optimality stops the other ones; otherwise the best solver at the time limit wins. The time and nodes limits of the
+ * command line are used by all solvers, and the presolve and symmetry of the command line are done once, before the
+ * race. The winner writes the .out and .sol files, and <output>.portfolio has one line by solver.
+ **/
+#ifndef __PORTFOLIO_MOCHILA__
+#define __PORTFOLIO_MOCHILA__
+#include "scip/scip.h"
+#include "problem.h"
+#include "parameters_mochila.h"
+
+// races the configurations of the portfolio file on the instance I (file filename)
+SCIP_RETCODE portfolioSolve(char* program, char* filename, instanceT* I, parametersT* param, char* portfoliofile, char* outputname);
+#endif
@@ -0,0 +1,303 @@
+/**@file   presolve_mochila.c
+ * @brief  problem specific presolve of the knapsack with forfeit sets
+ *
+ * Item k dominates item i if v_k >= v_i, w_k <= w_i and the sets of k are a subset of the sets of i (identical items are
+ * ordered by the index: the first one dominates). Replacing i by k never decreases the value nor increases the weight
+ * or the count of any set, so there is an optimal solution where x_i = 1 implies x_k = 1 for every k that dominates i.
+ * Hence x_i = 0 if i and its dominators D(i) do not fit in the capacity, or if they alone exceed the limit k:
+ *    sum_{j in sets(i)} max(0, 1 + |{k in D(i): j in sets(k)}| - h_j) > k.
+ * Items heavier than the capacity are also removed, and the upper bound of v_j is min(n_j, card_j) - h_j (at most k),
+ * where card_j is the total of the lightest items of S_j that fit in the capacity.
+ * The candidates to dominators of i are scanned by increasing weight and only while they are not heavier than i. The
+ * scan is still O(n^2) in the worst case, so it is skipped (dominance=0) in the core mode, made for the large instances.
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include "presolve_mochila.h"
+
+//#define DEBUG_PRESOLVE 1
+
+/** item and its weight, to scan the candidates to dominators by increasing weight */
+typedef struct{
+   int weight;
+   int item;
+} presolveItemT;
+
+/** checks if the sets of item k are a subset of the sets of item i (the lists are sorted) */
+static int setsSubset(instanceT* I, int k, int i)
+{
+   int a, b;
+
+   if(I->item[k].nsets > I->item[i].nsets)
+      return 0;
+   for(a=0,b=0;a<I->item[k].nsets;a++){
+      while(b<I->item[i].nsets && I->item[i].set[b] < I->item[k].set[a])
+         b++;
+      if(b==I->item[i].nsets || I->item[i].set[b] != I->item[k].set[a])
+         return 0;
+      b++;
+   }
+   return 1;
+}
+/** checks if item k dominates item i */
+static int dominates(instanceT* I, int k, int i)
+{
+   if(I->item[k].value < I->item[i].value || I->item[k].weight > I->item[i].weight)
+      return 0;
+   if(!setsSubset(I, k, i))
+      return 0;
+   // identical items: the first one dominates
+   if(I->item[k].value == I->item[i].value && I->item[k].weight == I->item[i].weight && I->item[k].nsets == I->item[i].nsets)
+      return k < i;
+   return 1;
+}
+static int compareInt(const void* a, const void* b)
+{
+   return *(int*)a - *(int*)b;
+}
+static int compareWeight(const void* a, const void* b)
+{
+   const presolveItemT* x = (const presolveItemT*) a, *y = (const presolveItemT*) b;
+
+   return x->weight != y->weight ? x->weight - y->weight : x->item - y->item;
+}
+
+int presolveInstance(instanceT* I, instanceT** R, presolveStatsT* stats, int dominance)
+{
+   int i, k, c, j, s, t, nR, weight, viol, card, total, *keep, *newindex, *count, *w;
+   presolveItemT* order;
+
+   memset(stats, 0, sizeof(presolveStatsT));
+   keep = (int*) malloc(sizeof(int)*I->n);
+   count = (int*) calloc(I->nS, sizeof(int));
+   // a dominator is not heavier than the dominated item
+   order = (presolveItemT*) malloc(sizeof(presolveItemT)*(I->n+1));
+   for(i=0;i<I->n;i++){
+      order[i].weight = I->item[i].weight;
+      order[i].item = i;
+   }
+   qsort(order, I->n, sizeof(presolveItemT), compareWeight);
+   for(i=0;i<I->n;i++){
+      keep[i] = 1;
+      if(I->item[i].weight > I->C){
+         keep[i] = 0;
+         stats->nheavy++;
+         continue;
+      }
+      if(!dominance)
+         continue;
+      // i and its dominators
+      weight = I->item[i].weight;
+      for(s=0;s<I->item[i].nsets;s++)
+         count[I->item[i].set[s]] = 1;
+      for(c=0;c<I->n && order[c].weight <= I->item[i].weight && weight <= I->C;c++){
+         k = order[c].item;
+         if(k != i && dominates(I, k, i)){
+            weight += I->item[k].weight;
+            for(s=0;s<I->item[k].nsets;s++)
+               count[I->item[k].set[s]]++;
+         }
+      }
+      viol = 0;
+      for(s=0;s<I->item[i].nsets;s++){
+         j = I->item[i].set[s];
+         if(count[j] > I->S[j].h)
+            viol += count[j] - I->S[j].h;
+         count[j] = 0;
+      }
+      if(weight > I->C || viol > I->k){
+         keep[i] = 0;
+         stats->ndominated++;
+      }
+#ifdef DEBUG_PRESOLVE
+      if(!keep[i])
+         printf("\nPresolve: item %d fixed in 0 (weight with dominators=%d, violations=%d)", I->item[i].label, weight, viol);
+#endif
+   }
+   free(count);
+   free(order);
+
+   // reduced instance: same forfeit sets, only the items kept
+   newindex = (int*) malloc(sizeof(int)*I->n);
+   nR = 0;
+   for(i=0;i<I->n;i++)
+      newindex[i] = keep[i] ? nR++ : -1;
+   createInstance(R, nR, I->nS, I->C);
+   (*R)->k = I->k;
+   for(i=0;i<I->n;i++){
+      if(!keep[i])
+         continue;
+      t = newindex[i];
+      (*R)->item[t].label = I->item[i].label;
+      (*R)->item[t].value = I->item[i].value;
+      (*R)->item[t].weight = I->item[i].weight;
+      (*R)->item[t].nsets = I->item[i].nsets;
+      (*R)->item[t].set = (int*) malloc(sizeof(int)*(I->item[i].nsets+1));
+      memcpy((*R)->item[t].set, I->item[i].set, sizeof(int)*I->item[i].nsets);
+   }
+   w = (int*) malloc(sizeof(int)*(nR+1));
+   for(j=0;j<I->nS;j++){
+      (*R)->S[j].j = I->S[j].j;
+      (*R)->S[j].h = I->S[j].h;
+      (*R)->S[j].d = I->S[j].d;
+      (*R)->S[j].items = (int*) malloc(sizeof(int)*(I->S[j].n+1));
+      (*R)->S[j].n = 0;
+      for(s=0;s<I->S[j].n;s++){
+         if(keep[I->S[j].items[s]]){
+            t = newindex[I->S[j].items[s]];
+            w[(*R)->S[j].n] = (*R)->item[t].weight;
+            (*R)->S[j].items[((*R)->S[j].n)++] = t;
+         }
+      }
+      // the lightest items of the set that fit in the capacity
+      qsort(w, (*R)->S[j].n, sizeof(int), compareInt);
+      total = 0;
+      for(card=0;card<(*R)->S[j].n && total + w[card] <= I->C;card++)
+         total += w[card];
+      (*R)->S[j].vub = card - I->S[j].h;
+      if((*R)->S[j].vub > I->k)
+         (*R)->S[j].vub = I->k;
+      if((*R)->S[j].vub < 0)
+         (*R)->S[j].vub = 0;
+      if((*R)->S[j].vub < I->S[j].vub)
+         stats->nvub++;
+   }
+   free(w);
+   free(newindex);
+   free(keep);
+   return I->n - nR;
+}
+
+/** hash of the signature of an item: value, weight and the (sorted) list of sets */
+static unsigned int itemHash(itemType* item)
+{
+   unsigned int h;
+   int s;
+
+   h = (unsigned int) item->value*31u + (unsigned int) item->weight;
+   h = h*31u + (unsigned int) item->nsets;
+   for(s=0;s<item->nsets;s++)
+      h = h*31u + (unsigned int) item->set[s];
+   return h;
+}
+/** checks if two items have the same signature */
+static int sameItem(itemType* a, itemType* b)
+{
+   if(a->value != b->value || a->weight != b->weight || a->nsets != b->nsets)
+      return 0;
+   return !memcmp(a->set, b->set, sizeof(int)*a->nsets);
+}
+
+int compressInstance(instanceT* I, instanceT** R)
+{
+   int i, j, s, t, c, nR, size, *first, *next, *rep, *newindex;
+
+   // hash table with chaining of the representative items
+   for(size=1;size<2*I->n;size*=2)
+      ;
+   first = (int*) malloc(sizeof(int)*size);
+   next = (int*) malloc(sizeof(int)*(I->n+1));
+   rep = (int*) malloc(sizeof(int)*(I->n+1));
+   newindex = (int*) malloc(sizeof(int)*(I->n+1));
+   for(i=0;i<size;i++)
+      first[i] = -1;
+   nR = 0;
+   for(i=0;i<I->n;i++){
+      t = (int) (itemHash(&I->item[i]) & (unsigned int) (size-1));
+      for(c=first[t];c>=0 && !sameItem(&I->item[c], &I->item[i]);c=next[c])
+         ;
+      if(c<0){
+         // new signature: i represents its group
+         next[i] = first[t];
+         first[t] = i;
+         rep[i] = i;
+         newindex[i] = nR++;
+      }
+      else{
+         rep[i] = c;
+         newindex[i] = newindex[c];
+      }
+   }
+   createInstance(R, nR, I->nS, I->C);
+   (*R)->k = I->k;
+   for(i=0;i<I->n;i++){
+      t = newindex[i];
+      if(rep[i] == i){
+         (*R)->item[t].label = I->item[i].label;
+         (*R)->item[t].value = I->item[i].value;
+         (*R)->item[t].weight = I->item[i].weight;
+         (*R)->item[t].nsets = I->item[i].nsets;
+         (*R)->item[t].set = (int*) malloc(sizeof(int)*(I->item[i].nsets+1));
+         memcpy((*R)->item[t].set, I->item[i].set, sizeof(int)*I->item[i].nsets);
+         (*R)->item[t].mult = 0;
+      }
+      (*R)->item[t].mult += I->item[i].mult;
+   }
+   // labels of the merged items (next is reused as the total of labels already copied)
+   for(t=0;t<nR;t++)
+      next[t] = 0;
+   for(i=0;i<I->n;i++){
+      t = newindex[i];
+      if((*R)->item[t].mult == 1)
+         continue;
+      if((*R)->item[t].labels == NULL)
+         (*R)->item[t].labels = (int*) malloc(sizeof(int)*(*R)->item[t].mult);
+      if(I->item[i].labels){
+         memcpy((*R)->item[t].labels + next[t], I->item[i].labels, sizeof(int)*I->item[i].mult);
+         next[t] += I->item[i].mult;
+      }
+      else
+         (*R)->item[t].labels[next[t]++] = I->item[i].label;
+   }
+   // the sets keep the same data, with the representative items
+   for(j=0;j<I->nS;j++){
+      (*R)->S[j].j = I->S[j].j;
+      (*R)->S[j].h = I->S[j].h;
+      (*R)->S[j].d = I->S[j].d;
+      (*R)->S[j].vub = I->S[j].vub;
+      (*R)->S[j].items = (int*) malloc(sizeof(int)*(I->S[j].n+1));
+      (*R)->S[j].n = 0;
+      for(s=0;s<I->S[j].n;s++){
+         i = I->S[j].items[s];
+         if(rep[i] == i)
+            (*R)->S[j].items[((*R)->S[j].n)++] = newindex[i];
+      }
+   }
+#ifdef DEBUG_PRESOLVE
+   for(t=0;t<nR;t++)
+      if((*R)->item[t].mult > 1)
+         printf("\nCompress: item %d represents %d identical items", (*R)->item[t].label, (*R)->item[t].mult);
+#endif
+   free(newindex);
+   free(rep);
+   free(next);
+   free(first);
+   return I->n - nR;
+}
+
+const char* symmetryConflict(const parametersT* param)
+{
+   if(param->heur_rf)
+      return "--heur_rf";
+   if(param->heur_lns)
+      return "--heur_lns";
+   if(param->heur_rins)
+      return "--heur_rins";
+   if(param->heur_lb)
+      return "--heur_lb";
+   if(param->heur_pr)
+      return "--heur_pr";
+   if(param->heur_aleatoria)
+      return "--heur_aleatoria";
+   if(param->pool_size > 0)
+      return "--pool_size";
+   if(param->sepa_forfeit)
+      return "--sepa_forfeit";
+   if(param->reopt_file != NULL)
+      return "--reopt";
+   // the configurations of the portfolio are read after the compression
+   if(param->portfolio_file != NULL)
+      return "--portfolio";
+   return NULL;
+}
@@ -0,0 +1,31 @@
+/**@file   presolve_mochila.h
+ * @brief  problem specific presolve of the knapsack with forfeit sets, done on instanceT before the model is created
+ *
+ * The reduced instance keeps the labels of the original items, so the solutions are written with the original items.
+ * The compression of identical items is a separated step, done after the presolve: each group of identical items
+ * becomes one item with multiplicity mult, and the labels of the group are kept in labels[]. Only the model, cons_forfeit,
+ * prop_redcost, branch_forfeit and the core mode handle mult: the dynamic programming, the solution states and the
+ * heuristics built on them (rf, lns, rins, lb, pr, aleatoria, the elite pool, the warm starts) and the separator assume
+ * binary items, so the compression is turned off with them (symmetryConflict).
+ **/
+#ifndef __PRESOLVE_MOCHILA__
+#define __PRESOLVE_MOCHILA__
+#include "problem.h"
+#include "parameters_mochila.h"
+
+/** reductions done by the presolve */
+typedef struct{
+   int nheavy;        /**< items heavier than the capacity */
+   int ndominated;    /**< dominated items fixed in 0 */
+   int nvub;          /**< upper bounds of v_j tightened */
+} presolveStatsT;
+
+// creates the reduced instance R of I (I must not be compressed). The dominance check (O(n^2) in the worst case) is
+// done only if dominance=1. Returns the total of removed items
+int presolveInstance(instanceT* I, instanceT** R, presolveStatsT* stats, int dominance);
+// creates the instance R where the identical items of I (same value, weight and forfeit sets) are merged in one item
+// with multiplicity mult. Returns the total of removed items
+int compressInstance(instanceT* I, instanceT** R);
+// returns the option that assumes binary items and forbids the compression (NULL: the compression can be done)
+const char* symmetryConflict(const parametersT* param);
+#endif
@@ -71,10 +71,12 @@
 
 #include <assert.h>
 #include <string.h>
+#include <time.h>
 
 #include "scip/scipdefplugins.h"
 
 #include "probdata_mochila.h"
+#include "cons_forfeit.h"
 
 /**@name Local methods
  *
@@ -117,6 +119,14 @@ SCIP_RETCODE probdataCreate(
    (*probdata)->ncons = ncons;
    (*probdata)->probname = probname;
    (*probdata)->param = param;
+   /* no global state: the random numbers are local to this SCIP */
+   SCIP_CALL( SCIPcreateRandom(scip, &(*probdata)->randnumgen, param->seed >= 0 ? (unsigned int) param->seed : (unsigned int) time(NULL), FALSE) );
+   memset((*probdata)->profile, 0, sizeof((*probdata)->profile));
+   if(param->heur_profile){
+      profileCreate(&(*probdata)->profile[PROFILE_ALEATORIA], "aleatoria");
+      profileCreate(&(*probdata)->profile[PROFILE_RF], "rf");
+      profileCreate(&(*probdata)->profile[PROFILE_LNS], "lns");
+   }
 
    return SCIP_OKAY;
 }
@@ -148,6 +158,9 @@ SCIP_RETCODE probdataFree(
 
    /* free memory of arrays */
    SCIPfreeMemoryArray(scip, &(*probdata)->conss);
+   SCIPfreeRandom(scip, &(*probdata)->randnumgen);
+   for( i = 0; i < PROFILE_NHEURS; ++i )
+      profileFree(&(*probdata)->profile[i]);
    //   if(!transformed){
      //SCIPfreeMemoryArray(scip, &(*probdata)->vars);
       //     freeInstance((*probdata)->I);
@@ -193,6 +206,66 @@ SCIP_DECL_PROBTRANS(probtransMochila)
    return SCIP_OKAY;
 }
 
+/** copies user data of source SCIP for the target SCIP (concurrent solve and sub-SCIPs created by SCIPcopy()).
+ *  The instance and the parameters are shared: they are only read by the plugins */
+static
+SCIP_DECL_PROBCOPY(probcopyMochila)
+{
+   SCIP_VAR** vars;
+   SCIP_CONS** conss;
+   SCIP_CONS* cons;
+   SCIP_Bool success;
+   int i, nvars, ncons;
+
+   (*result) = SCIP_DIDNOTRUN;
+   SCIP_CALL( SCIPallocBufferArray(scip, &vars, sourcedata->nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &conss, sourcedata->ncons) );
+
+   /* the copies of the variables are not captured by SCIPgetVarCopy() */
+   success = TRUE;
+   for( nvars = 0; nvars < sourcedata->nvars && success; ++nvars )
+   {
+      SCIP_CALL( SCIPgetVarCopy(sourcescip, scip, sourcedata->vars[nvars], &vars[nvars], varmap, consmap, global, &success) );
+      if( !success )
+         break;
+      SCIP_CALL( SCIPcaptureVar(scip, vars[nvars]) );
+   }
+   /* the copies of the constraints are captured by SCIPgetConsCopy() */
+   for( ncons = 0; ncons < sourcedata->ncons && success; ++ncons )
+   {
+      cons = sourcedata->conss[ncons];
+      SCIP_CALL( SCIPgetConsCopy(sourcescip, scip, cons, &conss[ncons], SCIPconsGetHdlr(cons), varmap, consmap,
+            SCIPconsGetName(cons), SCIPconsIsInitial(cons), SCIPconsIsSeparated(cons), SCIPconsIsEnforced(cons),
+            SCIPconsIsChecked(cons), SCIPconsIsPropagated(cons), SCIPconsIsLocal(cons), SCIPconsIsModifiable(cons),
+            SCIPconsIsDynamic(cons), SCIPconsIsRemovable(cons), SCIPconsIsStickingAtNode(cons), global, &success) );
+      if( !success )
+         break;
+   }
+
+   if( success )
+   {
+      SCIP_CALL( probdataCreate(scip, targetdata, sourcedata->probname, vars, conss, nvars, ncons, sourcedata->I, sourcedata->param) );
+      (*result) = SCIP_SUCCESS;
+   }
+   else
+   {
+      /* without the problem data the plugins can not run in the copy */
+      for( i = 0; i < nvars; ++i )
+      {
+         SCIP_CALL( SCIPreleaseVar(scip, &vars[i]) );
+      }
+      for( i = 0; i < ncons; ++i )
+      {
+         SCIP_CALL( SCIPreleaseCons(scip, &conss[i]) );
+      }
+      *targetdata = NULL;
+   }
+   SCIPfreeBufferArray(scip, &conss);
+   SCIPfreeBufferArray(scip, &vars);
+
+   return SCIP_OKAY;
+}
+
 /** frees user data of transformed problem (called when the transformed problem is freed) */
 static
 SCIP_DECL_PROBDELTRANS(probdeltransMochila)
@@ -239,7 +312,9 @@ SCIP_RETCODE SCIPprobdataCreate(
    instanceT*            I,                  /**< instance of knapsack */
    int                   relaxed,            /**< should be relaxed? */
    int*                  fixed,              /**< vector of fixed items */
-   parametersT*          param               /**< pointer to the config parameters */
+   parametersT*          param,              /**< pointer to the config parameters */
+   probdataExtraConsT    extracons,          /**< callback to add extra constraints (or NULL) */
+   void*                 extradata           /**< data passed to extracons */
    )
 {
    SCIP_PROBDATA* probdata;
@@ -261,6 +336,7 @@ SCIP_RETCODE SCIPprobdataCreate(
    SCIP_CALL( SCIPsetProbDeltrans(scip, probdeltransMochila) );
    SCIP_CALL( SCIPsetProbInitsol(scip, probinitsolMochila) );
    SCIP_CALL( SCIPsetProbExitsol(scip, probexitsolMochila) );
+   SCIP_CALL( SCIPsetProbCopy(scip, probcopyMochila) );
 
    /* set objective sense */
    SCIP_CALL( SCIPsetObjsense(scip, SCIP_OBJSENSE_MAXIMIZE) );
@@ -300,17 +376,18 @@ SCIP_RETCODE SCIPprobdataCreate(
    for( i = 0; i < I->n; nvars++, ++i )
    {
       (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "x_%d", i);
+      // x_i counts the copies of item i selected: binary, or integer in [0,mult] when identical items were merged
       if(!fixed){
          lbvar = 0.0;
-         ubvar = 1.0;
+         ubvar = (double) I->item[i].mult;
       }
       else{
          lbvar = fixed[i]==1?1.0:0.0; // if (fixed[i]==1) { lb=1.0 e ub = 1.0 }
-         ubvar = fixed[i]==-1?0.0:1.0; // if(fixed[i]==-1) { lb = 0.0 e ub = 0.0 }
+         ubvar = fixed[i]==-1?0.0:(double) I->item[i].mult; // if(fixed[i]==-1) { lb = 0.0 e ub = 0.0 }
       }
       /* create a basic variable object */
       if(!relaxed){
-         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, lbvar, ubvar, (double) I->item[i].value, SCIP_VARTYPE_BINARY) );
+         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, lbvar, ubvar, (double) I->item[i].value, I->item[i].mult > 1 ? SCIP_VARTYPE_INTEGER : SCIP_VARTYPE_BINARY) );
       }
       else{
          SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, lbvar, ubvar, (double) I->item[i].value, SCIP_VARTYPE_CONTINUOUS) );
@@ -332,10 +409,10 @@ SCIP_RETCODE SCIPprobdataCreate(
       (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "v_%d", j);
       /* create a basic variable object */
       if(!relaxed){
-         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, (double) I->S[j].n - I->S[j].h, (double) -I->S[j].d, SCIP_VARTYPE_INTEGER) );
+         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, (double) I->S[j].vub, (double) -I->S[j].d, SCIP_VARTYPE_INTEGER) );
       }
       else{
-         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, (double) I->S[j].n - I->S[j].h, (double) -I->S[j].d, SCIP_VARTYPE_CONTINUOUS) );
+         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, (double) I->S[j].vub, (double) -I->S[j].d, SCIP_VARTYPE_CONTINUOUS) );
       }
       assert(var != NULL);
       /* save the pointer to the created var */
@@ -358,6 +435,20 @@ SCIP_RETCODE SCIPprobdataCreate(
       }
    }
 
+   /* forfeit structure constraint: propagation of the sets and the limit k together (the linear rows are kept) */
+   if(param->cons_forfeit){
+      SCIP_CONS* cons;
+
+      SCIP_CALL( SCIPcreateConsForfeit(scip, &cons, "forfeit", I, vars) );
+      SCIP_CALL( SCIPaddCons(scip, cons) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+   }
+
+   /* extra constraints of the caller (local branching, for instance). They are not kept in the problem data */
+   if(extracons != NULL){
+      SCIP_CALL( extracons(scip, vars, I, extradata) );
+   }
+
    // TODO: ... after vars and constraints have been created, nothing more is necessary. Just do exactly as follows:
    /* create problem data */
    SCIP_CALL( probdataCreate(scip, &probdata, probname, vars, conss, nvars, ncons, I, param) );
@@ -432,4 +523,19 @@ const parametersT* SCIPprobdataGetParam(
 {
    return probdata->param;
 }
+/** returns the random number generator of the problem (each SCIP has its own one) */
+SCIP_RANDNUMGEN* SCIPprobdataGetRandnumgen(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   return probdata->randnumgen;
+}
+/** returns the profile of the heuristic (PROFILE_ALEATORIA, PROFILE_RF or PROFILE_LNS), NULL if it is off */
+heurProfileT* SCIPprobdataGetProfile(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   heur                /**< heuristic */
+   )
+{
+   return probdata->profile[heur];
+}
 /**@} */
\ No newline at end of file
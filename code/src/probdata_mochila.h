@@ -29,6 +29,7 @@
 #include "scip/scip.h"
 #include "problem.h"
 #include "parameters_mochila.h"
+#include "profile_mochila.h"
 
 /* constants */
 
@@ -53,6 +54,8 @@ struct SCIP_ProbData
    int                   ncons;              /**< number of constraints */
    instanceT*            I;                  /**< instance of knapsack */
    parametersT*          param;              /**< pointer to the config parameters */
+   SCIP_RANDNUMGEN*      randnumgen;         /**< random numbers of the heuristics (seed: --seed) */
+   heurProfileT*         profile[PROFILE_NHEURS]; /**< profiles of the heuristics (NULL: --heur_profile 0) */
 };
 
 /** sets up the problem data */
@@ -63,7 +66,9 @@ SCIP_RETCODE SCIPprobdataCreate(
    instanceT*            I,                   /**< instance of K-coloring */
    int                   relaxed,            /**< should be relaxed? */
    int*                  fixed,              /**< vector of fixed items */
-   parametersT*          param               /**< pointer to the config parameters */
+   parametersT*          param,              /**< pointer to the config parameters */
+   probdataExtraConsT    extracons,          /**< callback to add extra constraints (or NULL) */
+   void*                 extradata           /**< data passed to extracons */
    );
 
 /** adds given variable to the problem data */
@@ -112,4 +117,13 @@ instanceT* SCIPprobdataGetInstance(
 const parametersT* SCIPprobdataGetParam(
    SCIP_PROBDATA*        probdata            /**< problem data */
    );
+/** returns the random number generator of the problem (each SCIP has its own one) */
+SCIP_RANDNUMGEN* SCIPprobdataGetRandnumgen(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   );
+/** returns the profile of the heuristic (PROFILE_ALEATORIA, PROFILE_RF or PROFILE_LNS), NULL if it is off */
+heurProfileT* SCIPprobdataGetProfile(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   heur                /**< heuristic */
+   );
 #endif
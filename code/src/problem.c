@@ -5,6 +5,7 @@
  **/ 
 #include<stdio.h>
 #include<math.h>
+#include<string.h>
 #include "scip/scip.h"
 #include "problem.h"
 #include "probdata_mochila.h"
@@ -16,6 +17,7 @@ void freeInstance(instanceT* I)
    if(I){
       for(i=0;i<I->n;i++){
          free(I->item[i].set);
+         free(I->item[i].labels);
       }
       free(I->item);
       for(j=0;j<I->nS;j++)
@@ -35,6 +37,31 @@ void createInstance(instanceT** I, int n, int nS, int C)
   (*I)->n = n;
   (*I)->nS = nS;
   (*I)->C = C;
+  for(i=0;i<n;i++){
+     (*I)->item[i].mult = 1;
+     (*I)->item[i].labels = NULL;
+  }
+}
+void copyInstance(instanceT* I, instanceT** copy)
+{
+  int i, j;
+
+  createInstance(copy, I->n, I->nS, I->C);
+  (*copy)->k = I->k;
+  for(i=0;i<I->n;i++){
+     (*copy)->item[i] = I->item[i];
+     (*copy)->item[i].set = (int*) malloc(sizeof(int)*(I->item[i].nsets+1));
+     memcpy((*copy)->item[i].set, I->item[i].set, sizeof(int)*I->item[i].nsets);
+     if(I->item[i].labels){
+        (*copy)->item[i].labels = (int*) malloc(sizeof(int)*I->item[i].mult);
+        memcpy((*copy)->item[i].labels, I->item[i].labels, sizeof(int)*I->item[i].mult);
+     }
+  }
+  for(j=0;j<I->nS;j++){
+     (*copy)->S[j] = I->S[j];
+     (*copy)->S[j].items = (int*) malloc(sizeof(int)*(I->S[j].n+1));
+     memcpy((*copy)->S[j].items, I->S[j].items, sizeof(int)*I->S[j].n);
+  }
 }
 void printInstance(instanceT* I)
 {
@@ -49,7 +76,7 @@ void printInstance(instanceT* I)
   }
   printf("\nItems= \n");
   for(i=0;i<I->n;i++){
-     printf("%d value=%d weight=%d sets={", I->item[i].label, I->item[i].value, I->item[i].weight);
+     printf("%d value=%d weight=%d mult=%d sets={", I->item[i].label, I->item[i].value, I->item[i].weight, I->item[i].mult);
      for(j=0;j<I->item[i].nsets;j++){
         printf("%d ", I->item[i].set[j]);
      }
@@ -59,35 +86,68 @@ void printInstance(instanceT* I)
 int loadInstance(char* filename, instanceT** I)
 {
   FILE* fin;
-  int n, nS, i, j, C, ii;
+  int ok;
+
   fin = fopen(filename, "r");
   if(!fin){
     printf("\nProblem to open file %s\n", filename);
     return 0;
   }
+  ok = readInstance(fin, I);
+  fclose(fin);
+  return ok;
+}
+int readInstance(FILE* fin, instanceT** I)
+{
+  int n, nS, i, j, C, ii, ok;
 
-  fscanf(fin,"%d %d %d\n", &n, &nS, &C);
+  *I = NULL;
+  if(fscanf(fin,"%d %d %d\n", &n, &nS, &C) != 3 || n <= 0 || nS < 0)
+    return 0;
   createInstance(I, n, nS, C);
+  // the arrays are NULL until they are read, so an incomplete instance can be freed
   for(i=0; i<n; i++){
-     fscanf(fin, "%d\n", &((*I)->item[i].value));
      (*I)->item[i].label=i;
      (*I)->item[i].nsets=0;
-  }
-  for(i=0; i<n; i++){
-     fscanf(fin, "%d\n", &((*I)->item[i].weight));
+     (*I)->item[i].set=NULL;
   }
   for(j=0; j<nS; j++){
+     (*I)->S[j].n = 0;
+     (*I)->S[j].items = NULL;
+  }
+  ok = 1;
+  for(i=0; i<n && ok; i++){
+     ok = fscanf(fin, "%d\n", &((*I)->item[i].value)) == 1;
+  }
+  for(i=0; i<n && ok; i++){
+     ok = fscanf(fin, "%d\n", &((*I)->item[i].weight)) == 1;
+  }
+  for(j=0; j<nS && ok; j++){
      (*I)->S[j].j = j;
-     fscanf(fin,"%d %d %d\n", &((*I)->S[j].h), &((*I)->S[j].d), &((*I)->S[j].n));
-     (*I)->S[j].items = (int*)malloc(sizeof(int)*((*I)->S[j].n));
-     for(i=0; i<(*I)->S[j].n; i++){
-        fscanf(fin, "%d", &ii);
-        ((*I)->S[j].items[i]) = ii;
-        ((*I)->item[ii].nsets)++;
+     ok = fscanf(fin,"%d %d %d\n", &((*I)->S[j].h), &((*I)->S[j].d), &((*I)->S[j].n)) == 3 && (*I)->S[j].n >= 0 && (*I)->S[j].n <= n;
+     if(!ok){
+        (*I)->S[j].n = 0;
+        break;
+     }
+     (*I)->S[j].vub = (*I)->S[j].n > (*I)->S[j].h ? (*I)->S[j].n - (*I)->S[j].h : 0;
+     (*I)->S[j].items = (int*)malloc(sizeof(int)*((*I)->S[j].n+1));
+     for(i=0; i<(*I)->S[j].n && ok; i++){
+        ok = fscanf(fin, "%d", &ii) == 1 && ii >= 0 && ii < n;
+        if(ok){
+           ((*I)->S[j].items[i]) = ii;
+           ((*I)->item[ii].nsets)++;
+        }
      }
   }
+  if(ok)
+     ok = fscanf(fin, "\nk %d", &((*I)->k)) == 1;
+  if(!ok){
+     freeInstance(*I);
+     *I = NULL;
+     return 0;
+  }
   for(i=0; i<n; i++){
-     (*I)->item[i].set = (int*)malloc(sizeof(int)*((*I)->item[i].nsets));
+     (*I)->item[i].set = (int*)malloc(sizeof(int)*((*I)->item[i].nsets+1));
      (*I)->item[i].nsets = 0;
   }
   for(j=0; j<nS; j++){
@@ -96,16 +156,19 @@ int loadInstance(char* filename, instanceT** I)
         (*I)->item[ii].set[((*I)->item[ii].nsets)++] = j;
      }
   }
-  fscanf(fin, "\nk %d", &((*I)->k));
-  fclose(fin);
   return 1;
 }
 // load instance problem into SCIP
 int loadProblem(SCIP* scip, char* probname, instanceT* I, int relaxed, int* fixed, parametersT* param)
+{
+  return loadProblemExtra(scip, probname, I, relaxed, fixed, param, NULL, NULL);
+}
+// load instance problem into SCIP, with extra constraints added by extracons
+int loadProblemExtra(SCIP* scip, char* probname, instanceT* I, int relaxed, int* fixed, parametersT* param, probdataExtraConsT extracons, void* extradata)
 {
   SCIP_RETCODE ret_code;
 
-  ret_code = SCIPprobdataCreate(scip, probname, I, relaxed, fixed, param);
+  ret_code = SCIPprobdataCreate(scip, probname, I, relaxed, fixed, param, extracons, extradata);
   if(ret_code!=SCIP_OKAY)
     return 0;
   return 1;
@@ -11,6 +11,8 @@ typedef struct{
   int weight;
   int nsets; /**< total of forfeit set where item belongs to */
   int *set;  /**< forfeit sets that contain the item */
+  int mult;  /**< total of identical items represented by this item (1: no compression) */
+  int *labels; /**< labels of the identical items merged in this item (NULL if mult==1) */
 }itemType;
 
 /** structure for each forfeit set */
@@ -19,6 +21,7 @@ typedef struct{
    int h; /**< maximum of items without to pay the forfeit cost */
    int d; /**< forfeit cost */
    int n; /**< total of items in the forfeit set */
+   int vub; /**< upper bound of the violations v_j (n - h, or tightened by the presolve) */
    int *items; /**< list of items in the forfeit set */
 }forfeitType;
 
@@ -31,11 +34,21 @@ typedef struct{
   itemType *item; /**< data for each item in 0..n-1 */
 } instanceT;
 
+/** callback to add extra constraints to the model, called after all variables were created.
+ *  vars has the same order of SCIPprobdataGetVars(): x_0..x_{n-1}, v_0..v_{nS-1} */
+typedef SCIP_RETCODE (*probdataExtraConsT)(SCIP* scip, SCIP_VAR** vars, instanceT* I, void* data);
+
 void freeInstance(instanceT* I);
 void createInstance(instanceT** I, int n, int nS, int C);
 void printInstance(instanceT* I);
+// creates a copy of I (items, sets and labels)
+void copyInstance(instanceT* I, instanceT** copy);
 // load instance from a file
 int loadInstance(char* filename, instanceT** I);
+// read instance from an open stream (same format of the file). Returns 0 if the data is incomplete or invalid
+int readInstance(FILE* fin, instanceT** I);
 // load instance problem into SCIP
 int loadProblem(SCIP* scip, char* probname, instanceT* in, int relaxed, int* fixed, parametersT* param);
+// load instance problem into SCIP, with extra constraints added by extracons
+int loadProblemExtra(SCIP* scip, char* probname, instanceT* in, int relaxed, int* fixed, parametersT* param, probdataExtraConsT extracons, void* extradata);
 #endif
@@ -0,0 +1,109 @@
+/**@file   profile_mochila.c
+ * @brief  per-call profiling of the primal heuristics aleatoria, rf and lns
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<math.h>
+#include "profile_mochila.h"
+#include "run_mochila.h"
+
+static const char* phaseName[PROFILE_NPHASES] = {"setup", "solve", "transfer", "trysol", "other", "total"};
+
+void profileCreate(heurProfileT** profile, const char* name)
+{
+   *profile = (heurProfileT*) calloc(1, sizeof(heurProfileT));
+   (*profile)->name = name;
+}
+
+void profileFree(heurProfileT** profile)
+{
+   int p;
+
+   if(*profile == NULL)
+      return;
+   for(p=0;p<PROFILE_NPHASES;p++)
+      free((*profile)->samples[p]);
+   free(*profile);
+   *profile = NULL;
+}
+
+void profileCallStart(heurProfileT* profile)
+{
+   if(profile == NULL)
+      return;
+   memset(profile->call, 0, sizeof(profile->call));
+   profile->start = wallTime();
+}
+
+void profileCallEnd(heurProfileT* profile)
+{
+   int p;
+
+   if(profile == NULL)
+      return;
+   if(profile->ncalls == profile->maxcalls){
+      profile->maxcalls = 2*profile->maxcalls + 64;
+      for(p=0;p<PROFILE_NPHASES;p++)
+         profile->samples[p] = (double*) realloc(profile->samples[p], sizeof(double)*profile->maxcalls);
+   }
+   profile->call[PROFILE_TOTAL] = wallTime() - profile->start;
+   profile->call[PROFILE_OTHER] = profile->call[PROFILE_TOTAL];
+   for(p=0;p<PROFILE_OTHER;p++)
+      profile->call[PROFILE_OTHER] -= profile->call[p];
+   for(p=0;p<PROFILE_NPHASES;p++)
+      profile->samples[p][profile->ncalls] = profile->call[p];
+   profile->ncalls++;
+}
+
+double profileStart(heurProfileT* profile)
+{
+   return profile != NULL ? wallTime() : 0.0;
+}
+
+void profileStop(heurProfileT* profile, int phase, double start)
+{
+   if(profile != NULL)
+      profile->call[phase] += wallTime() - start;
+}
+
+static int compareDouble(const void* a, const void* b)
+{
+   double x = *(const double*) a, y = *(const double*) b;
+
+   return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// value of the sorted samples at the percentile q (nearest rank)
+static double percentile(double* sorted, int n, double q)
+{
+   int r;
+
+   r = (int) ceil(q*n) - 1;
+   return sorted[r < 0 ? 0 : r];
+}
+
+void profileWrite(FILE* fout, heurProfileT* profile)
+{
+   double* sorted, total;
+   int p, c;
+
+   if(profile == NULL)
+      return;
+   if(profile->ncalls == 0){
+      for(p=0;p<PROFILE_NPHASES;p++)
+         fprintf(fout, "%s;%s;0;0;0;0;0;0\n", profile->name, phaseName[p]);
+      return;
+   }
+   sorted = (double*) malloc(sizeof(double)*profile->ncalls);
+   for(p=0;p<PROFILE_NPHASES;p++){
+      memcpy(sorted, profile->samples[p], sizeof(double)*profile->ncalls);
+      qsort(sorted, profile->ncalls, sizeof(double), compareDouble);
+      total = 0.0;
+      for(c=0;c<profile->ncalls;c++)
+         total += sorted[c];
+      fprintf(fout, "%s;%s;%d;%lf;%lf;%lf;%lf;%lf\n", profile->name, phaseName[p], profile->ncalls, total, total/profile->ncalls,
+         percentile(sorted, profile->ncalls, 0.50), percentile(sorted, profile->ncalls, 0.95), sorted[profile->ncalls-1]);
+   }
+   free(sorted);
+}
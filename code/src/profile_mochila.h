@@ -0,0 +1,37 @@
+/**@file   profile_mochila.h
+ * @brief  per-call profiling of the primal heuristics aleatoria, rf and lns
+ *
+ * Each call of a heuristic is split in phases: setup (configScip, loadProblem and SCIPfree of the sub-SCIP), solve
+ * (SCIPsolve of the sub-SCIP), transfer (SCIPcreateSol/SCIPsetSolVal of the solution in the original SCIP), trysol
+ * (SCIPtrySol) and other (the rest of the call, as the construction of aleatoria or the neighborhood and the dynamic
+ * programming of lns). Each call keeps one sample by phase, and the percentiles are computed at the end.
+ * A NULL profile turns off all the functions (no clock is read).
+ **/
+#ifndef __PROFILE_MOCHILA__
+#define __PROFILE_MOCHILA__
+#include<stdio.h>
+
+enum {PROFILE_SETUP, PROFILE_SOLVE, PROFILE_TRANSFER, PROFILE_TRYSOL, PROFILE_OTHER, PROFILE_TOTAL, PROFILE_NPHASES};
+enum {PROFILE_ALEATORIA, PROFILE_RF, PROFILE_LNS, PROFILE_NHEURS};
+
+/** samples of the calls of one heuristic */
+typedef struct{
+   const char* name;
+   int ncalls;
+   int maxcalls;
+   double* samples[PROFILE_NPHASES]; /**< samples[phase][call]: wall time of the phase in the call (in sec) */
+   double call[PROFILE_NPHASES];     /**< phases of the call in progress */
+   double start;                     /**< start of the call in progress */
+} heurProfileT;
+
+void profileCreate(heurProfileT** profile, const char* name);
+void profileFree(heurProfileT** profile);
+// starts and ends one call of the heuristic
+void profileCallStart(heurProfileT* profile);
+void profileCallEnd(heurProfileT* profile);
+// profileStop(profile, phase, profileStart(profile)) adds the time between them to the phase of the call in progress
+double profileStart(heurProfileT* profile);
+void profileStop(heurProfileT* profile, int phase, double start);
+// writes one line "heur;phase;calls;total;mean;p50;p95;max" by phase
+void profileWrite(FILE* fout, heurProfileT* profile);
+#endif
@@ -0,0 +1,244 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_redcost.c
+ * @brief  reduced cost fixing of the item variables x and of the violation variables v
+ *
+ * Let z_LP be the value of the LP of the node (transformed problem, minimization), cutoff the cutoff bound given by the
+ * incumbent and rc_k the reduced cost of a variable nonbasic in the LP. If rc_k > 0 the variable is at its lower bound
+ * and any solution better than the incumbent has x_k <= lb_k + (cutoff - z_LP)/rc_k; if rc_k < 0 it is at its upper
+ * bound and x_k >= ub_k - (cutoff - z_LP)/(-rc_k). For the binary x_i this fixes the variable; for v_j (and the merged
+ * items) the bound is tightened. At the root the reductions are global, below it they are local to the subtree.
+ * The generic redcost propagator of SCIP is turned off in configScip when this one is used, so the reductions are not
+ * done twice.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "prop_redcost.h"
+
+//#define DEBUG_REDCOST 1
+#define PROP_NAME              "redcostmochila"
+#define PROP_DESC              "reduced cost fixing of the items and of the violations"
+#define PROP_TIMING            SCIP_PROPTIMING_DURINGLPLOOP
+#define PROP_PRIORITY          1000000 /**< propagator priority */
+#define PROP_FREQ              1 /**< propagator frequency */
+#define PROP_DELAY             FALSE /**< should propagation method be delayed, if other propagators found reductions? */
+
+/*
+ * Data structures
+ */
+
+/** propagator data */
+struct SCIP_PropData
+{
+   const parametersT*    param;              /**< pointer to the config parameters */
+   SCIP_Longint          nglobal;            /**< bounds tightened at the root (global) */
+   SCIP_Longint          nlocal;             /**< bounds tightened below the root (local) */
+};
+
+/*
+ * Local methods
+ */
+
+/** tightens the bounds of var with its reduced cost. Returns the change in nchg */
+static
+SCIP_RETCODE redcostVar(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var,                /**< variable */
+   SCIP_Real             gap,                /**< cutoff bound minus the LP value */
+   SCIP_Bool             global,             /**< should the bounds be changed globally? */
+   SCIP_Bool*            cutoff,             /**< pointer to store whether the node is infeasible */
+   int*                  nchg                /**< pointer to count the changed bounds */
+   )
+{
+   SCIP_Real rc, lb, ub, bound;
+   SCIP_Bool infeasible, tightened;
+
+   lb = SCIPvarGetLbLocal(var);
+   ub = SCIPvarGetUbLocal(var);
+   if(ub - lb < 0.5)
+      return SCIP_OKAY;
+   rc = SCIPgetVarRedcost(scip, var);
+   infeasible = tightened = FALSE;
+   if(SCIPisDualfeasPositive(scip, rc)){
+      // nonbasic at the lower bound
+      bound = lb + SCIPfeasFloor(scip, gap/rc);
+      if(bound < ub - 0.5){
+         if(global){
+            SCIP_CALL( SCIPtightenVarUbGlobal(scip, var, bound, FALSE, &infeasible, &tightened) );
+         }
+         else{
+            SCIP_CALL( SCIPtightenVarUb(scip, var, bound, FALSE, &infeasible, &tightened) );
+         }
+      }
+   }
+   else if(SCIPisDualfeasNegative(scip, rc)){
+      // nonbasic at the upper bound
+      bound = ub - SCIPfeasFloor(scip, gap/(-rc));
+      if(bound > lb + 0.5){
+         if(global){
+            SCIP_CALL( SCIPtightenVarLbGlobal(scip, var, bound, FALSE, &infeasible, &tightened) );
+         }
+         else{
+            SCIP_CALL( SCIPtightenVarLb(scip, var, bound, FALSE, &infeasible, &tightened) );
+         }
+      }
+   }
+   if(infeasible)
+      *cutoff = TRUE;
+   if(tightened){
+      (*nchg)++;
+#ifdef DEBUG_REDCOST
+      printf("\nRedcost: %s in [%g,%g] (rc=%g, gap=%g)", SCIPvarGetName(var), SCIPvarGetLbLocal(var), SCIPvarGetUbLocal(var), rc, gap);
+#endif
+   }
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of propagator
+ */
+
+/** copy method for propagator plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_PROPCOPY(propCopyRedcostMochila)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(prop != NULL);
+
+   /* call inclusion method of propagator */
+   SCIP_CALL( SCIPincludePropRedcostMochila(scip, SCIPpropGetData(prop)->param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of propagator to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_PROPFREE(propFreeRedcostMochila)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+   SCIPfreeMemory(scip, &propdata);
+   SCIPpropSetData(prop, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of propagator */
+static
+SCIP_DECL_PROPEXEC(propExecRedcostMochila)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_Real gap;
+   SCIP_Bool global, cutoff;
+   instanceT* I;
+   int k, nvars, nchg;
+
+   *result = SCIP_DIDNOTRUN;
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+
+   // the reduced costs are only valid for the optimal LP of the node, and only with an incumbent
+   if(!SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL || SCIPinProbing(scip) || SCIPinDive(scip))
+      return SCIP_OKAY;
+   if(SCIPisInfinity(scip, SCIPgetCutoffbound(scip)))
+      return SCIP_OKAY;
+   gap = SCIPgetCutoffbound(scip) - SCIPgetLPObjval(scip);
+   if(gap < 0.0)
+      return SCIP_OKAY;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   nvars = I->n + I->nS;
+
+   *result = SCIP_DIDNOTFIND;
+   global = SCIPgetDepth(scip) == 0;
+   cutoff = FALSE;
+   nchg = 0;
+   for(k=0;k<nvars && !cutoff;k++){
+      SCIP_CALL( redcostVar(scip, vars[k], gap, global, &cutoff, &nchg) );
+   }
+   if(global)
+      propdata->nglobal += nchg;
+   else
+      propdata->nlocal += nchg;
+   if(cutoff)
+      *result = SCIP_CUTOFF;
+   else if(nchg > 0)
+      *result = SCIP_REDUCEDDOM;
+
+   return SCIP_OKAY;
+}
+
+/*
+ * propagator specific interface methods
+ */
+
+/** returns the total of global and local reductions found by the reduced cost propagator */
+void SCIPpropRedcostGetNReductions(
+   SCIP*                 scip,                /**< SCIP data structure */
+   SCIP_Longint*         nglobal,             /**< pointer to store the global reductions */
+   SCIP_Longint*         nlocal               /**< pointer to store the local reductions */
+   )
+{
+   SCIP_PROP* prop;
+
+   *nglobal = *nlocal = 0;
+   prop = SCIPfindProp(scip, PROP_NAME);
+   if(prop == NULL)
+      return;
+   *nglobal = SCIPpropGetData(prop)->nglobal;
+   *nlocal = SCIPpropGetData(prop)->nlocal;
+}
+
+/** creates the reduced cost propagator and includes it in SCIP */
+SCIP_RETCODE SCIPincludePropRedcostMochila(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_PROPDATA* propdata;
+   SCIP_PROP* prop;
+
+   /* create reduced cost propagator data */
+   SCIP_CALL( SCIPallocMemory(scip, &propdata) );
+   propdata->param = param;
+   propdata->nglobal = 0;
+   propdata->nlocal = 0;
+
+   prop = NULL;
+   /* include propagator */
+   SCIP_CALL( SCIPincludePropBasic(scip, &prop, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY, PROP_TIMING,
+         propExecRedcostMochila, propdata) );
+   assert(prop != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetPropCopy(scip, prop, propCopyRedcostMochila) );
+   SCIP_CALL( SCIPsetPropFree(scip, prop, propFreeRedcostMochila) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,54 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_redcost.h
+ * @ingroup PROPAGATORS
+ * @brief  reduced cost fixing of the item variables x and of the violation variables v
+ *
+ * Uses the reduced costs of the LP solution of the node and the gap to the incumbent to tighten the bounds of x_i and
+ * v_j. The reductions are global at the root and local below it.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PROP_REDCOST_H__
+#define __SCIP_PROP_REDCOST_H__
+
+
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** returns the total of global and local reductions found by the reduced cost propagator */
+void SCIPpropRedcostGetNReductions(
+   SCIP*                 scip,                /**< SCIP data structure */
+   SCIP_Longint*         nglobal,             /**< pointer to store the global reductions */
+   SCIP_Longint*         nlocal               /**< pointer to store the local reductions */
+   );
+
+/** creates the reduced cost propagator and includes it in SCIP */
+SCIP_RETCODE SCIPincludePropRedcostMochila(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,175 @@
+/**@file   reopt_mochila.c
+ * @brief  re-optimization of the instance after small changes read from a delta file
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include "reopt_mochila.h"
+#include "probdata_mochila.h"
+#include "solstate.h"
+#include "utils.h"
+#include "run_mochila.h"
+#include "event_solstream.h"
+
+//#define DEBUG_REOPT 1
+
+/** one change of the delta file */
+typedef struct{
+   char type;  /**< v, w, C, k, h or d */
+   int index;  /**< item or set (not used by C and k) */
+   int value;  /**< new value */
+} deltaT;
+
+/** reads the next block of changes. Returns the total of changes, or -1 at the end of the file */
+static int readBlock(FILE* fin, instanceT* I, deltaT** delta, int* size)
+{
+   char token[100];
+   int n;
+
+   n = 0;
+   while(fscanf(fin, "%99s", token) == 1){
+      if(token[0] == '#'){
+         if(fscanf(fin, "%*[^\n]") < 0)
+            break;
+         continue;
+      }
+      if(!strcmp(token, "solve"))
+         return n;
+      if(n == *size){
+         *size = 2*(*size) + 1;
+         *delta = (deltaT*) realloc(*delta, sizeof(deltaT)*(*size));
+      }
+      (*delta)[n].type = token[0];
+      (*delta)[n].index = 0;
+      if(token[0] == 'C' || token[0] == 'k'){
+         if(fscanf(fin, "%d", &(*delta)[n].value) != 1)
+            break;
+      }
+      else if(fscanf(fin, "%d %d", &(*delta)[n].index, &(*delta)[n].value) != 2)
+         break;
+      // invalid changes are ignored
+      if((strchr("vw", token[0]) && (*delta)[n].index >= 0 && (*delta)[n].index < I->n) ||
+         (strchr("hd", token[0]) && (*delta)[n].index >= 0 && (*delta)[n].index < I->nS) || strchr("Ck", token[0]))
+         n++;
+      else
+         printf("\nReopt: invalid change %s %d ignored", token, (*delta)[n].index);
+   }
+   return n > 0 ? n : -1;
+}
+
+/** repairs the solution x for the changed instance */
+static void repairSolution(instanceT* I, int* x)
+{
+   solstateT* S;
+
+   solstateCreate(&S, I);
+   solstateLoad(S, x);
+   solstateRepair(S);
+   memcpy(x, S->x, sizeof(int)*I->n);
+   solstateFree(&S);
+}
+
+SCIP_RETCODE reoptSolve(SCIP* scip, instanceT* I, parametersT* param, char* deltafile, char* outputname)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_CONS** conss;
+   SCIP_SOL* sol;
+   SCIP_Real* obj;
+   SCIP_Bool stored;
+   FILE* fin;
+   deltaT* delta;
+   double start, end;
+   char name[SCIP_MAXSTRLEN];
+   int i, j, c, n, size, round, objonly, *x;
+
+   fin = fopen(deltafile, "r");
+   if(!fin){
+      printf("\nProblem to open delta file %s\n", deltafile);
+      return SCIP_NOFILE;
+   }
+   x = (int*) malloc(sizeof(int)*I->n);
+   size = 0;
+   delta = NULL;
+   for(round=1;(n = readBlock(fin, I, &delta, &size)) >= 0;round++){
+      // incumbent of the previous solve
+      probdata = SCIPgetProbData(scip);
+      vars = SCIPprobdataGetVars(probdata);
+      for(i=0;i<I->n;i++)
+         x[i] = SCIPgetBestSol(scip) != NULL && SCIPgetSolVal(scip, SCIPgetBestSol(scip), vars[i]) > 0.5;
+      objonly = 1;
+      for(c=0;c<n;c++){
+         if(delta[c].type != 'v' && delta[c].type != 'd')
+            objonly = 0;
+      }
+      // patch the instance
+      for(c=0;c<n;c++){
+         i = j = delta[c].index;
+         switch(delta[c].type){
+         case 'v': I->item[i].value = delta[c].value; break;
+         case 'w': I->item[i].weight = delta[c].value; break;
+         case 'C': I->C = delta[c].value; break;
+         case 'k': I->k = delta[c].value; break;
+         case 'd': I->S[j].d = delta[c].value; break;
+         case 'h':
+            I->S[j].h = delta[c].value;
+            I->S[j].vub = I->S[j].n > I->S[j].h ? I->S[j].n - I->S[j].h : 0;
+            break;
+         }
+      }
+      if(objonly && param->reopt_scip){
+         // SCIP reoptimization: the search tree of the previous solve is reused with the new objective
+         SCIP_CALL( SCIPfreeReoptSolve(scip) );
+         vars = SCIPgetOrigVars(scip); // x_0..x_{n-1}, v_0..v_{nS-1}, in the order of SCIPprobdataCreate()
+         obj = (SCIP_Real*) malloc(sizeof(SCIP_Real)*(I->n+I->nS));
+         for(i=0;i<I->n;i++)
+            obj[i] = (SCIP_Real) I->item[i].value;
+         for(j=0;j<I->nS;j++)
+            obj[I->n+j] = (SCIP_Real) -I->S[j].d;
+         SCIP_CALL( SCIPchgReoptObjective(scip, SCIP_OBJSENSE_MAXIMIZE, vars, obj, I->n+I->nS) );
+         free(obj);
+      }
+      else{
+         // back to the original problem and patch the model in place
+         SCIP_CALL( SCIPfreeTransform(scip) );
+         probdata = SCIPgetProbData(scip);
+         vars = SCIPprobdataGetVars(probdata);
+         conss = SCIPprobdataGetConss(probdata);
+         for(c=0;c<n;c++){
+            i = j = delta[c].index;
+            switch(delta[c].type){
+            case 'v': SCIP_CALL( SCIPchgVarObj(scip, vars[i], (SCIP_Real) I->item[i].value) ); break;
+            case 'w': SCIP_CALL( SCIPchgCoefLinear(scip, conss[0], vars[i], (SCIP_Real) I->item[i].weight) ); break;
+            case 'C': SCIP_CALL( SCIPchgRhsLinear(scip, conss[0], (SCIP_Real) I->C) ); break;
+            case 'k': SCIP_CALL( SCIPchgRhsLinear(scip, conss[1+I->nS], (SCIP_Real) I->k) ); break;
+            case 'd': SCIP_CALL( SCIPchgVarObj(scip, vars[I->n+j], (SCIP_Real) -I->S[j].d) ); break;
+            case 'h':
+               SCIP_CALL( SCIPchgRhsLinear(scip, conss[1+j], (SCIP_Real) I->S[j].h) );
+               SCIP_CALL( SCIPchgVarUb(scip, vars[I->n+j], (SCIP_Real) I->S[j].vub) );
+               break;
+            }
+         }
+      }
+      // previous incumbent as start solution
+      repairSolution(I, x);
+      SCIP_CALL( createSolFromItems(scip, NULL, x, &sol) );
+      SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      printf("\nReopt %d: %d changes, %s, start solution %s\n", round, n, objonly && param->reopt_scip ? "SCIP reoptimization" : "model patched", stored ? "accepted" : "rejected");
+
+      // the solutions of the round are streamed to its own files (no-op without --sol_stream)
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s-reopt%d", outputname, round);
+      SCIPeventhdlrSolstreamSetOutput(scip, name);
+
+      // same timer of the base solve in runInstance (the re-optimization has no concurrent solve)
+      start = threadTime();
+      SCIP_CALL( SCIPsolve(scip) );
+      end = threadTime();
+      SCIPeventhdlrSolstreamFlush(scip);
+      printStatistic(scip, end-start, name, NULL);
+      printSol(scip, name);
+   }
+   free(delta);
+   free(x);
+   fclose(fin);
+   return SCIP_OKAY;
+}
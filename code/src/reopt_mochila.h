@@ -0,0 +1,23 @@
+/**@file   reopt_mochila.h
+ * @brief  re-optimization of the instance after small changes read from a delta file
+ *
+ * The delta file has blocks of changes, each one ended by a line "solve" (or by the end of the file):
+ *    v <item> <value>     value of an item
+ *    w <item> <weight>    weight of an item
+ *    C <capacity>         capacity of the knapsack
+ *    k <limit>            limit of violations
+ *    h <set> <limit>      items of a forfeit set without the forfeit cost
+ *    d <set> <cost>       forfeit cost of a set
+ * Items and sets are numbered from 0, as in the instance file, and lines starting with # are comments.
+ * After each block the instance and the model are changed in place and solved again, starting from the previous
+ * incumbent (repaired if it became infeasible). If only the objective changed (v and d), SCIP reoptimization is used.
+ **/
+#ifndef __REOPT_MOCHILA__
+#define __REOPT_MOCHILA__
+#include "scip/scip.h"
+#include "problem.h"
+#include "parameters_mochila.h"
+
+// solves again the instance I (already solved in scip) for each block of the delta file
+SCIP_RETCODE reoptSolve(SCIP* scip, instanceT* I, parametersT* param, char* deltafile, char* outputname);
+#endif
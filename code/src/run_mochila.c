@@ -0,0 +1,255 @@
+/**@file   run_mochila.c
+ * @brief  solves one instance file with the given parameters and writes the .out and .sol files
+ **/
+#define _POSIX_C_SOURCE 199309L
+#include<stdio.h>
+#include<time.h>
+#include<string.h>
+#include<sys/resource.h>
+
+#include "scip/scip.h"
+#include "problem.h"
+#include "utils.h"
+#include "run_mochila.h"
+#include "presolve_mochila.h"
+#include "core_mochila.h"
+#include "reopt_mochila.h"
+#include "sweep_mochila.h"
+#include "portfolio_mochila.h"
+#include "event_solstream.h"
+
+double threadTime()
+{
+  struct timespec t;
+
+  // clock() would count the time of all threads of the batch mode
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+  return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+double wallTime()
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+double processTime()
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+  return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+long peakRSS()
+{
+  struct rusage usage;
+
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+  return usage.ru_maxrss;
+}
+
+void phaseInit(phaseTimesT* phases, int batch)
+{
+  memset(phases, 0, sizeof(phaseTimesT));
+  phases->batch = batch;
+  phases->wallstart = wallTime();
+  phases->cpustart = batch ? threadTime() : processTime();
+}
+
+void phaseEnd(phaseTimesT* phases, int phase)
+{
+  double wall, cpu;
+
+  wall = wallTime();
+  cpu = phases->batch ? threadTime() : processTime();
+  phases->wall[phase] += wall - phases->wallstart;
+  phases->cpu[phase] += cpu - phases->cpustart;
+  phases->wallstart = wall;
+  phases->cpustart = cpu;
+}
+
+void phasePrint(const phaseTimesT* phases)
+{
+  static const char* name[NPHASES] = {"setup", "load", "config", "build", "write", "solve", "output"};
+  double wall, cpu;
+  int p;
+
+  wall = cpu = 0.0;
+  printf("\nPhase        wall (s)    cpu (s)");
+  for(p=0;p<NPHASES;p++){
+    printf("\n%-8s %12.3lf %10.3lf", name[p], phases->wall[p], phases->cpu[p]);
+    wall += phases->wall[p];
+    cpu += phases->cpu[p];
+  }
+  printf("\n%-8s %12.3lf %10.3lf", "total", wall, cpu);
+  printf("\nPeak RSS: %ld KB\n", peakRSS());
+}
+
+SCIP_RETCODE runInstance(char* program, char* filename, parametersT* param, int batch, phaseTimesT* phases)
+{
+  SCIP* scip;
+  instanceT* in, *reduced;
+  presolveStatsT pstats;
+  phaseTimesT local;
+  int removed;
+  double start, end;
+  char outputname[SCIP_MAXSTRLEN];
+
+  // the setup of the parameters was timed by the caller
+  if(phases == NULL){
+    phases = &local;
+    phaseInit(phases, batch);
+  }
+  else{
+    phaseEnd(phases, PHASE_SETUP);
+  }
+  // load instance file
+  if(!loadInstance(filename, &in)){
+    printf("\nProblem to read instance file %s\n", filename);
+    return SCIP_READERROR;
+  }
+#ifdef DEBUG
+  printInstance(in);
+#endif
+  // the re-optimization changes the instance in place: items and bounds can not be removed
+  if(param->reopt_file != NULL && (param->presolve || param->symmetry || param->core)){
+     printf("\nReopt: presolve, symmetry and core mode turned off\n");
+     param->presolve = param->symmetry = param->core = 0;
+  }
+  // the concurrent solve does not support re-optimization
+  if(param->reopt_file != NULL && param->threads > 1){
+     printf("\nReopt: concurrent solve turned off\n");
+     param->threads = 1;
+  }
+  // the presolve depends on C and k, and the warm starts of the points are binary solution states
+  if(param->sweep_file != NULL && (param->presolve || param->symmetry || param->core)){
+     printf("\nSweep: presolve, symmetry and core mode turned off\n");
+     param->presolve = param->symmetry = param->core = 0;
+  }
+  // the solvers of the portfolio write only the .out and .sol files of the winner
+  if(param->portfolio_file != NULL && (param->reopt_file != NULL || param->sweep_file != NULL || param->core)){
+     printf("\nPortfolio: reopt, sweep and core mode turned off\n");
+     param->reopt_file = param->sweep_file = NULL;
+     param->core = 0;
+  }
+  // the core mode solves several models: only the .sol file of the end is written
+  if(param->sol_stream && param->core){
+     printf("\nSol stream: not available in core mode\n");
+  }
+  // path relinking only walks between solutions of the elite pool
+  if(param->heur_pr && param->pool_size == 0){
+     printf("\nPr: the elite pool is off (--pool_size 0), pr finds no pairs\n");
+  }
+  // the dynamic programming, the solution states and the heuristics built on them assume binary items
+  if(param->symmetry && symmetryConflict(param) != NULL){
+     printf("\nSymmetry: turned off (%s assumes binary items)\n", symmetryConflict(param));
+     param->symmetry = 0;
+  }
+  // problem specific presolve: the model and the heuristics use the reduced instance (the items keep their labels)
+  if(param->presolve){
+     removed = presolveInstance(in, &reduced, &pstats, !param->core);
+     printf("\nPresolve %s: %d items removed (%d heavy, %d dominated), %d bounds of v tightened\n", filename, removed, pstats.nheavy, pstats.ndominated, pstats.nvub);
+     freeInstance(in);
+     in = reduced;
+  }
+  // identical items are merged in one integer variable
+  if(param->symmetry){
+     removed = compressInstance(in, &reduced);
+     printf("\nSymmetry %s: %d identical items merged, %d items (%d variables x) left\n", filename, removed, in->n, reduced->n);
+     freeInstance(in);
+     in = reduced;
+  }
+  // config output filename
+  configOutputName(outputname, filename, program, param);
+  phaseEnd(phases, PHASE_LOAD);
+  // parametric sweep: one table of results instead of the .out and .sol files
+  if(param->sweep_file != NULL){
+    SCIP_CALL( sweepSolve(in, param, param->sweep_file, outputname) );
+    freeInstance(in);
+    phaseEnd(phases, PHASE_SOLVE);
+    if(!batch)
+      phasePrint(phases);
+    return SCIP_OKAY;
+  }
+  // portfolio: several configurations race on the instance
+  if(param->portfolio_file != NULL){
+    SCIP_CALL( portfolioSolve(program, filename, in, param, param->portfolio_file, outputname) );
+    freeInstance(in);
+    phaseEnd(phases, PHASE_SOLVE);
+    if(!batch)
+      phasePrint(phases);
+    return SCIP_OKAY;
+  }
+  if(param->core){
+    // core mode: scip is the last core solved (its config and build are part of the solve)
+    start = threadTime();
+    SCIP_CALL( coreSolve(&scip, filename, in, param, batch) );
+    end = threadTime();
+    phaseEnd(phases, PHASE_SOLVE);
+  }
+  else{
+    // create scip and set scip configurations
+    configScip(&scip, param);
+    if(batch){
+      SCIPsetMessagehdlrQuiet(scip, TRUE);
+    }
+    // each improving solution is written while solving (in a writer thread)
+    if(param->sol_stream){
+      SCIP_CALL( SCIPincludeEventhdlrSolstream(scip, outputname) );
+    }
+    if(param->reopt_file != NULL && param->reopt_scip){
+      SCIP_CALL( SCIPenableReoptimization(scip, TRUE) );
+    }
+    phaseEnd(phases, PHASE_CONFIG);
+    // load problem into scip
+    if(!loadProblem(scip,filename,in,0,NULL,param)){
+      printf("\nProblem to load instance problem\n");
+      // the batch workers run many instances in the same process
+      SCIP_CALL( SCIPfree(&scip) );
+      freeInstance(in);
+      return SCIP_ERROR;
+    }
+    phaseEnd(phases, PHASE_BUILD);
+    // print problem, if requested (in batch mode the workers would write the same file)
+    if(param->write_lp != NULL && !batch){
+      SCIP_CALL( SCIPwriteOrigProblem(scip, param->write_lp, "lp", FALSE) );
+    }
+    phaseEnd(phases, PHASE_WRITE);
+    // solve scip problem
+    if(param->threads > 1){
+      // the CPU time of this thread does not count the other threads
+      start = wallTime();
+      SCIP_CALL( SCIPsolveConcurrent(scip) );
+      end = wallTime();
+    }
+    else{
+      start = threadTime();
+      SCIP_CALL( SCIPsolve(scip) );
+      end = threadTime();
+    }
+    phaseEnd(phases, PHASE_SOLVE);
+  }
+  // the writer thread of the solution stream must not rewrite the .sol file after printSol()
+  SCIPeventhdlrSolstreamFlush(scip);
+  if(param->sol_stream && !param->core){
+    printf("\nSol stream: %lld solutions written in %s.stream\n", (long long) SCIPeventhdlrSolstreamGetNSols(scip), outputname);
+  }
+  // print statistics and print resume in output file
+  printStatistic(scip, end-start, outputname, phases);
+  // write the best solution in a file
+  printSol(scip, outputname);
+  phaseEnd(phases, PHASE_OUTPUT);
+  if(!batch)
+    phasePrint(phases);
+  // solve again after each block of changes of the delta file
+  if(param->reopt_file != NULL){
+    SCIP_CALL( reoptSolve(scip, in, param, param->reopt_file, outputname) );
+  }
+  SCIP_CALL( SCIPfree(&scip) );
+  freeInstance(in);
+  return SCIP_OKAY;
+}
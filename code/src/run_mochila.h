@@ -0,0 +1,46 @@
+/**@file   run_mochila.h
+ * @brief  solves one instance file with the given parameters and writes the .out and .sol files
+ *
+ * It is the whole pipeline of the program for one instance: load, presolve, symmetry, solve (sweep, portfolio, core or the
+ * full model), statistics, solution and re-optimization. It is used by main() and by each worker of the batch mode.
+ *
+ * Each phase of the pipeline is timed in wall time (monotonic clock) and in CPU time: the CPU time is the time of the
+ * process in a single run (it counts the threads of the concurrent solve and of the solution stream) and the time of
+ * the calling thread in batch mode (the other workers would be counted otherwise).
+ **/
+#ifndef __RUN_MOCHILA__
+#define __RUN_MOCHILA__
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+// phases of a run: parameter setup, loadInstance (with the presolve and symmetry of the instance), configScip, model
+// build (loadProblem), SCIPwriteOrigProblem, solve and output (statistics and solution files)
+enum {PHASE_SETUP, PHASE_LOAD, PHASE_CONFIG, PHASE_BUILD, PHASE_WRITE, PHASE_SOLVE, PHASE_OUTPUT, NPHASES};
+
+/** wall and CPU times of the phases of a run */
+typedef struct{
+   double wall[NPHASES];   /**< wall time of each phase (in sec) */
+   double cpu[NPHASES];    /**< CPU time of each phase (in sec) */
+   double wallstart;       /**< start of the phase in progress */
+   double cpustart;
+   int batch;              /**< 1: the CPU time is the time of the calling thread */
+} phaseTimesT;
+
+// solves the instance in filename. In batch mode (batch=1) there is no output of SCIP in the console.
+// phases has the time of the parameter setup (NULL: not timed)
+SCIP_RETCODE runInstance(char* program, char* filename, parametersT* param, int batch, phaseTimesT* phases);
+// CPU time (in sec) of the calling thread
+double threadTime();
+// wall clock time (in sec)
+double wallTime();
+// CPU time (in sec) of the process
+double processTime();
+// peak resident set size of the process (in KB)
+long peakRSS();
+// clears the phases and starts the timers
+void phaseInit(phaseTimesT* phases, int batch);
+// adds the time since the last phaseInit/phaseEnd to the phase and starts the timers of the next phase
+void phaseEnd(phaseTimesT* phases, int phase);
+// writes "phase wall cpu" for each phase and the peak RSS in the console
+void phasePrint(const phaseTimesT* phases);
+#endif
@@ -0,0 +1,404 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   sepa_forfeit.c
+ * @brief  separator of cover and cardinality inequalities for the knapsack with forfeit sets
+ *
+ * Two families are separated:
+ *  - extended covers of the capacity row: a minimal cover C (sum_{i in C} w_i > C) is built greedily by (1 - x*_i)/w_i
+ *    and extended with the items heavier than the heaviest item of C: sum_{i in E(C)} x_i <= |C| - 1;
+ *  - cardinality of the forfeit sets: at most card_j items of S_j fit in the knapsack (the lightest ones) and at most
+ *    h_j + k items of S_j can be selected, so sum_{i in S_j} x_i <= min(card_j, h_j + k). The same is done for all
+ *    the items: sum_i x_i <= card.
+ * Only cuts with efficacy >= --sepa_minefficacy are added, at most --sepa_maxcuts by round (the most efficacious ones)
+ * and at most --sepa_maxrounds rounds by node. The cuts assume binary x, so the separator does not run when identical
+ * items were merged in integer variables (--symmetry).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "probdata_mochila.h"
+#include "parameters_mochila.h"
+#include "sepa_forfeit.h"
+
+//#define DEBUG_SEPA 1
+#define SEPA_NAME              "forfeit"
+#define SEPA_DESC              "cover and cardinality cuts for the knapsack with forfeit sets"
+#define SEPA_PRIORITY              1000 /**< priority of the separator */
+#define SEPA_FREQ                     0 /**< frequency for calling separator. 0 = only at the root */
+#define SEPA_MAXBOUNDDIST           1.0 /**< maximal relative distance from current node's dual bound to primal bound compared
+                                         *   to best node's dual bound for applying separation */
+#define SEPA_USESSUBSCIP          FALSE /**< does the separator use a secondary SCIP instance? */
+#define SEPA_DELAY                FALSE /**< should separation method be delayed, if other separators found cuts? */
+
+/*
+ * Data structures
+ */
+
+/** separator data */
+struct SCIP_SepaData
+{
+   const parametersT*    param;              /**< pointer to the config parameters */
+   int*                  cardrhs;            /**< right hand side of the cardinality cut of each set (n_j: no cut) */
+   int                   cardall;            /**< maximum of items in the knapsack */
+   SCIP_Bool             binary;             /**< are all x variables binary (no merged items)? */
+};
+
+/** cut found in one round */
+typedef struct{
+   SCIP_ROW*             row;
+   SCIP_Real             efficacy;
+} cutT;
+
+/*
+ * Local methods
+ */
+
+static
+int compareInt(const void* a, const void* b)
+{
+   return *(int*)a - *(int*)b;
+}
+
+/** maximum of items of the list that fit in the capacity: the lightest ones */
+static
+int maxItemsInCapacity(instanceT* I, int* items, int nitems, int* w)
+{
+   int i, total;
+
+   for(i=0;i<nitems;i++)
+      w[i] = I->item[items[i]].weight;
+   qsort(w, nitems, sizeof(int), compareInt);
+   total = 0;
+   for(i=0;i<nitems && total + w[i] <= I->C;i++)
+      total += w[i];
+   return i;
+}
+
+/** computes the right hand sides of the cardinality cuts */
+static
+void initCardinality(SCIP_SEPADATA* sepadata, instanceT* I)
+{
+   int i, j, card, *w, *all;
+
+   w = (int*) malloc(sizeof(int)*(I->n+1));
+   sepadata->cardrhs = (int*) malloc(sizeof(int)*(I->nS+1));
+   for(j=0;j<I->nS;j++){
+      card = maxItemsInCapacity(I, I->S[j].items, I->S[j].n, w);
+      if(card > I->S[j].h + I->k)
+         card = I->S[j].h + I->k;
+      sepadata->cardrhs[j] = card;
+   }
+   sepadata->binary = TRUE;
+   all = (int*) malloc(sizeof(int)*(I->n+1));
+   for(i=0;i<I->n;i++){
+      all[i] = i;
+      if(I->item[i].mult > 1)
+         sepadata->binary = FALSE;
+   }
+   sepadata->cardall = maxItemsInCapacity(I, all, I->n, w);
+   free(all);
+   free(w);
+}
+
+/** creates the row sum_{i in items} x_i <= rhs and saves it in cuts if it is violated and efficacious */
+static
+SCIP_RETCODE addCardinalityRow(
+   SCIP*                 scip,
+   SCIP_SEPA*            sepa,
+   SCIP_VAR**            vars,
+   const char*           name,
+   int*                  items,
+   int                   nitems,
+   int                   rhs,
+   SCIP_Real             minefficacy,
+   cutT*                 cuts,
+   int*                  ncuts
+   )
+{
+   SCIP_ROW* row;
+   SCIP_Real activity, efficacy;
+   int i;
+
+   activity = 0.0;
+   for(i=0;i<nitems;i++)
+      activity += SCIPgetSolVal(scip, NULL, vars[items[i]]);
+   if(activity <= rhs + EPSILON)
+      return SCIP_OKAY;
+   SCIP_CALL( SCIPcreateEmptyRowSepa(scip, &row, sepa, name, -SCIPinfinity(scip), (SCIP_Real) rhs, FALSE, FALSE, TRUE) );
+   SCIP_CALL( SCIPcacheRowExtensions(scip, row) );
+   for(i=0;i<nitems;i++){
+      SCIP_CALL( SCIPaddVarToRow(scip, row, vars[items[i]], 1.0) );
+   }
+   SCIP_CALL( SCIPflushRowExtensions(scip, row) );
+   efficacy = SCIPgetCutEfficacy(scip, NULL, row);
+   if(efficacy < minefficacy){
+      SCIP_CALL( SCIPreleaseRow(scip, &row) );
+      return SCIP_OKAY;
+   }
+   cuts[*ncuts].row = row;
+   cuts[(*ncuts)++].efficacy = efficacy;
+   return SCIP_OKAY;
+}
+
+/** ratio (1 - x*_i)/w_i used to build the cover */
+typedef struct{
+   double ratio;
+   int i;
+} coverKeyT;
+
+static
+int compareCoverKey(const void* a, const void* b)
+{
+   if(((coverKeyT*)a)->ratio < ((coverKeyT*)b)->ratio) return -1;
+   if(((coverKeyT*)a)->ratio > ((coverKeyT*)b)->ratio) return 1;
+   return ((coverKeyT*)a)->i - ((coverKeyT*)b)->i;
+}
+
+/** separates one extended cover inequality of the capacity row */
+static
+SCIP_RETCODE separateCover(
+   SCIP*                 scip,
+   SCIP_SEPA*            sepa,
+   SCIP_VAR**            vars,
+   instanceT*            I,
+   SCIP_Real             minefficacy,
+   cutT*                 cuts,
+   int*                  ncuts
+   )
+{
+   coverKeyT* keys;
+   SCIP_Real xval;
+   int i, t, nkeys, ncover, weight, wmax, *inCover, *items, nitems;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &keys, I->n) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &inCover, I->n) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &items, I->n) );
+   nkeys = 0;
+   for(i=0;i<I->n;i++){
+      inCover[i] = 0;
+      xval = SCIPgetSolVal(scip, NULL, vars[i]);
+      if(xval > EPSILON){
+         keys[nkeys].ratio = (1.0 - xval)/(I->item[i].weight > 0 ? I->item[i].weight : 1);
+         keys[nkeys++].i = i;
+      }
+   }
+   qsort(keys, nkeys, sizeof(coverKeyT), compareCoverKey);
+   // cover: items with the smallest ratios until the capacity is exceeded
+   weight = 0;
+   for(t=0;t<nkeys && weight <= I->C;t++){
+      weight += I->item[keys[t].i].weight;
+      inCover[keys[t].i] = 1;
+   }
+   ncover = t;
+   if(weight > I->C){
+      // minimal cover: remove items (largest ratios first) while it is still a cover
+      for(t=ncover-1;t>=0;t--){
+         i = keys[t].i;
+         if(weight - I->item[i].weight > I->C){
+            weight -= I->item[i].weight;
+            inCover[i] = 0;
+         }
+      }
+      // extension: the items at least as heavy as the heaviest item of the cover
+      wmax = 0;
+      ncover = 0;
+      for(i=0;i<I->n;i++){
+         if(inCover[i]){
+            ncover++;
+            if(I->item[i].weight > wmax)
+               wmax = I->item[i].weight;
+         }
+      }
+      nitems = 0;
+      for(i=0;i<I->n;i++){
+         if(inCover[i] || I->item[i].weight >= wmax)
+            items[nitems++] = i;
+      }
+      SCIP_CALL( addCardinalityRow(scip, sepa, vars, "cover", items, nitems, ncover - 1, minefficacy, cuts, ncuts) );
+   }
+   SCIPfreeBufferArray(scip, &items);
+   SCIPfreeBufferArray(scip, &inCover);
+   SCIPfreeBufferArray(scip, &keys);
+   return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of separator
+ */
+
+/** copy method for separator plugins (called when SCIP copies plugins) */
+static
+SCIP_DECL_SEPACOPY(sepaCopyForfeit)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(sepa != NULL);
+
+   /* call inclusion method of separator */
+   SCIP_CALL( SCIPincludeSepaForfeit(scip, SCIPsepaGetData(sepa)->param) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of separator to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_SEPAFREE(sepaFreeForfeit)
+{  /*lint --e{715}*/
+   SCIP_SEPADATA* sepadata;
+
+   sepadata = SCIPsepaGetData(sepa);
+   assert(sepadata != NULL);
+   SCIPfreeMemory(scip, &sepadata);
+   SCIPsepaSetData(sepa, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of separator (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_SEPAINITSOL(sepaInitsolForfeit)
+{  /*lint --e{715}*/
+   SCIP_SEPADATA* sepadata;
+
+   sepadata = SCIPsepaGetData(sepa);
+   assert(sepadata != NULL);
+   initCardinality(sepadata, SCIPprobdataGetInstance(SCIPgetProbData(scip)));
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of separator (called before branch and bound process data is freed) */
+static
+SCIP_DECL_SEPAEXITSOL(sepaExitsolForfeit)
+{  /*lint --e{715}*/
+   SCIP_SEPADATA* sepadata;
+
+   sepadata = SCIPsepaGetData(sepa);
+   assert(sepadata != NULL);
+   free(sepadata->cardrhs);
+   sepadata->cardrhs = NULL;
+
+   return SCIP_OKAY;
+}
+
+/** LP solution separation method of separator */
+static
+SCIP_DECL_SEPAEXECLP(sepaExeclpForfeit)
+{  /*lint --e{715}*/
+   SCIP_SEPADATA* sepadata;
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_Bool infeasible;
+   instanceT* I;
+   const parametersT* param;
+   char name[SCIP_MAXSTRLEN];
+   cutT* cuts, tmp;
+   int j, c, d, ncuts, maxcuts, *all;
+
+   *result = SCIP_DIDNOTRUN;
+   sepadata = SCIPsepaGetData(sepa);
+   assert(sepadata != NULL);
+   param = sepadata->param;
+   if(!sepadata->binary || (param->sepa_maxrounds >= 0 && SCIPsepaGetNCallsAtNode(sepa) >= param->sepa_maxrounds))
+      return SCIP_OKAY;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+   *result = SCIP_DIDNOTFIND;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &cuts, I->nS+2) );
+   ncuts = 0;
+   SCIP_CALL( separateCover(scip, sepa, vars, I, param->sepa_minefficacy, cuts, &ncuts) );
+   for(j=0;j<I->nS;j++){
+      if(sepadata->cardrhs[j] < I->S[j].n){
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "card_%d", j);
+         SCIP_CALL( addCardinalityRow(scip, sepa, vars, name, I->S[j].items, I->S[j].n, sepadata->cardrhs[j], param->sepa_minefficacy, cuts, &ncuts) );
+      }
+   }
+   if(sepadata->cardall < I->n){
+      SCIP_CALL( SCIPallocBufferArray(scip, &all, I->n) );
+      for(j=0;j<I->n;j++)
+         all[j] = j;
+      SCIP_CALL( addCardinalityRow(scip, sepa, vars, "card", all, I->n, sepadata->cardall, param->sepa_minefficacy, cuts, &ncuts) );
+      SCIPfreeBufferArray(scip, &all);
+   }
+   // the most efficacious cuts are added
+   maxcuts = ncuts < param->sepa_maxcuts ? ncuts : param->sepa_maxcuts;
+   infeasible = FALSE;
+   for(c=0;c<ncuts;c++){
+      if(c < maxcuts){
+         for(d=c+1;d<ncuts;d++){
+            if(cuts[d].efficacy > cuts[c].efficacy){
+               tmp = cuts[c]; cuts[c] = cuts[d]; cuts[d] = tmp;
+            }
+         }
+         if(!infeasible){
+#if (defined SCIP_VERSION_MAJOR)
+            SCIP_CALL( SCIPaddRow(scip, cuts[c].row, FALSE, &infeasible) );
+#else
+            SCIP_CALL( SCIPaddCut(scip, NULL, cuts[c].row, FALSE, &infeasible) );
+#endif
+            *result = infeasible ? SCIP_CUTOFF : SCIP_SEPARATED;
+#ifdef DEBUG_SEPA
+            printf("\nSepa forfeit: cut with efficacy %lf added", cuts[c].efficacy);
+#endif
+         }
+      }
+      SCIP_CALL( SCIPreleaseRow(scip, &cuts[c].row) );
+   }
+   SCIPfreeBufferArray(scip, &cuts);
+
+   return SCIP_OKAY;
+}
+
+/*
+ * separator specific interface methods
+ */
+
+/** creates the forfeit separator and includes it in SCIP */
+SCIP_RETCODE SCIPincludeSepaForfeit(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   )
+{
+   SCIP_SEPADATA* sepadata;
+   SCIP_SEPA* sepa;
+
+   /* create forfeit separator data */
+   SCIP_CALL( SCIPallocMemory(scip, &sepadata) );
+   sepadata->param = param;
+   sepadata->cardrhs = NULL;
+   sepadata->cardall = 0;
+   sepadata->binary = TRUE;
+
+   sepa = NULL;
+   /* include separator */
+   SCIP_CALL( SCIPincludeSepaBasic(scip, &sepa, SEPA_NAME, SEPA_DESC, SEPA_PRIORITY, SEPA_FREQ, SEPA_MAXBOUNDDIST,
+         SEPA_USESSUBSCIP, SEPA_DELAY, sepaExeclpForfeit, NULL, sepadata) );
+   assert(sepa != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetSepaCopy(scip, sepa, sepaCopyForfeit) );
+   SCIP_CALL( SCIPsetSepaFree(scip, sepa, sepaFreeForfeit) );
+   SCIP_CALL( SCIPsetSepaInitsol(scip, sepa, sepaInitsolForfeit) );
+   SCIP_CALL( SCIPsetSepaExitsol(scip, sepa, sepaExitsolForfeit) );
+
+   return SCIP_OKAY;
+}
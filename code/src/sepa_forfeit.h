@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   sepa_forfeit.h
+ * @ingroup SEPARATORS
+ * @brief  separator of cover and cardinality inequalities for the knapsack with forfeit sets
+ *
+ * extended cover inequalities of the capacity row and cardinality inequalities of each forfeit set given by the
+ * capacity and the limit k
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_SEPA_FORFEIT_H__
+#define __SCIP_SEPA_FORFEIT_H__
+
+
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the forfeit separator and includes it in SCIP */
+SCIP_RETCODE SCIPincludeSepaForfeit(
+   SCIP*                 scip,                /**< SCIP data structure */
+   const parametersT* param
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
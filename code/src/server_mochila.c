@@ -0,0 +1,430 @@
+/**@file   server_mochila.c
+ * @brief  server mode: solves the jobs of the clients in a pool of workers, each one with a warm SCIP
+ **/
+#define _GNU_SOURCE
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<errno.h>
+#include<signal.h>
+#include<unistd.h>
+#include<pthread.h>
+#include<sys/socket.h>
+#include<sys/stat.h>
+#include<sys/un.h>
+#include "server_mochila.h"
+#include "mochila.h"
+#include "problem.h"
+#include "utils.h"
+
+//#define DEBUG_SERVER 1
+#define SERVER_MAXOPTS 200
+
+/** connection with one client, shared by its reader and by the workers that answer its jobs */
+typedef struct{
+   FILE* in;
+   FILE* out;
+   int refs;          /**< the reader plus the jobs not answered */
+   int closefiles;    /**< 0: stdin/stdout are not closed */
+   pthread_mutex_t lock;
+} serverConnT;
+
+/** one job of a client */
+typedef struct{
+   serverConnT* conn;
+   char* id;
+   instanceT* I;
+   parametersT param;
+   char* values[SERVER_MAXOPTS]; /**< copies of the values of the options (the STRING parameters point to them) */
+   int nvalues;
+} serverJobT;
+
+/** bounded queue of jobs, filled by the readers and emptied by the workers */
+typedef struct{
+   parametersT* param;   /**< defaults of the jobs */
+   serverJobT** jobs;
+   int capacity;
+   int first;
+   int njobs;
+   int stop;             /**< 1: the workers stop when the queue is empty */
+   pthread_mutex_t lock;
+   pthread_cond_t notempty;
+   pthread_cond_t notfull;
+} serverT;
+
+/** data of a reader thread */
+typedef struct{
+   serverT* server;
+   serverConnT* conn;
+} serverReaderT;
+
+static serverConnT* connCreate(FILE* in, FILE* out, int closefiles)
+{
+   serverConnT* conn;
+
+   conn = (serverConnT*) malloc(sizeof(serverConnT));
+   conn->in = in;
+   conn->out = out;
+   conn->refs = 1;
+   conn->closefiles = closefiles;
+   pthread_mutex_init(&conn->lock, NULL);
+   return conn;
+}
+
+// drops one reference to conn; the last one closes the connection
+static void connRelease(serverConnT* conn)
+{
+   int refs;
+
+   pthread_mutex_lock(&conn->lock);
+   refs = --(conn->refs);
+   pthread_mutex_unlock(&conn->lock);
+   if(refs > 0)
+      return;
+   if(conn->closefiles){
+      fclose(conn->in);
+      fclose(conn->out);
+   }
+   else
+      fflush(conn->out);
+   pthread_mutex_destroy(&conn->lock);
+   free(conn);
+}
+
+static void connError(serverConnT* conn, const char* id, const char* msg)
+{
+   pthread_mutex_lock(&conn->lock);
+   fprintf(conn->out, "error %s %s\n", id, msg);
+   fflush(conn->out);
+   pthread_mutex_unlock(&conn->lock);
+}
+
+static void freeJob(serverJobT* job)
+{
+   int i;
+
+   freeInstance(job->I);
+   for(i=0;i<job->nvalues;i++)
+      free(job->values[i]);
+   free(job->id);
+   free(job);
+}
+
+// waits for a free place in the queue (admission control: the reader stops reading its connection)
+static void queuePush(serverT* server, serverJobT* job)
+{
+   pthread_mutex_lock(&server->lock);
+   while(server->njobs == server->capacity)
+      pthread_cond_wait(&server->notfull, &server->lock);
+   server->jobs[(server->first + server->njobs) % server->capacity] = job;
+   server->njobs++;
+   pthread_cond_signal(&server->notempty);
+   pthread_mutex_unlock(&server->lock);
+}
+
+// next job of the queue (NULL: the server stops)
+static serverJobT* queuePop(serverT* server)
+{
+   serverJobT* job = NULL;
+
+   pthread_mutex_lock(&server->lock);
+   while(server->njobs == 0 && !server->stop)
+      pthread_cond_wait(&server->notempty, &server->lock);
+   if(server->njobs > 0){
+      job = server->jobs[server->first];
+      server->first = (server->first + 1) % server->capacity;
+      server->njobs--;
+      pthread_cond_signal(&server->notfull);
+   }
+   pthread_mutex_unlock(&server->lock);
+   return job;
+}
+
+// reads one line without the end of line. Returns -1 at the end of the file
+static int readLine(FILE* fin, char** line, size_t* size)
+{
+   ssize_t len;
+
+   len = getline(line, size, fin);
+   if(len < 0)
+      return -1;
+   while(len > 0 && ((*line)[len-1] == '\n' || (*line)[len-1] == '\r'))
+      (*line)[--len] = '\0';
+   return (int) len;
+}
+
+// sets the options of one line "--option value ...". Returns 0 or the error of setParameterValue()
+static int setOptions(serverJobT* job, char* line, char* msg)
+{
+   char* name, *value, *save;
+   int error = 0;
+
+   for(name = strtok_r(line, " \t", &save); name != NULL && !error; name = strtok_r(NULL, " \t", &save)){
+      value = strtok_r(NULL, " \t", &save);
+      if(value == NULL || job->nvalues == SERVER_MAXOPTS)
+         error = PARAM_INVALID;
+      else{
+         job->values[job->nvalues] = strdup(value);
+         error = setParameterValue(&job->param, name, job->values[job->nvalues++]);
+      }
+      if(error)
+         snprintf(msg, SCIP_MAXSTRLEN, "parameter %s %s", name, error == PARAM_INVALID ? "invalid or uncompleted" : "out of range");
+   }
+   return error;
+}
+
+// reads the jobs of one connection and puts them in the queue
+static void* serverReader(void* arg)
+{
+   serverReaderT* reader = (serverReaderT*) arg;
+   serverT* server = reader->server;
+   serverConnT* conn = reader->conn;
+   serverJobT* job;
+   FILE* fin;
+   char msg[SCIP_MAXSTRLEN];
+   char* line = NULL, *text = NULL;
+   size_t size = 0, textsize = 0, textlen;
+   int len, error, eof;
+
+   free(reader);
+   eof = 0;
+   while(!eof && (len = readLine(conn->in, &line, &size)) >= 0){
+      if(len == 0 || line[0] == '#')
+         continue;
+      if(!strcmp(line, "quit"))
+         break;
+      if(strncmp(line, "job ", 4) || line[4] == '\0'){
+         connError(conn, "-", "expected job <id>");
+         continue;
+      }
+      job = (serverJobT*) calloc(1, sizeof(serverJobT));
+      job->conn = conn;
+      job->id = strdup(line+4);
+      job->param = *(server->param);
+      error = 0;
+      // options until "instance"
+      while(!(eof = readLine(conn->in, &line, &size) < 0) && strcmp(line, "instance")){
+         if(!error)
+            error = setOptions(job, line, msg);
+      }
+      // text of the instance until "end"
+      textlen = 0;
+      while(!eof && !(eof = readLine(conn->in, &line, &size) < 0) && strcmp(line, "end")){
+         len = strlen(line);
+         if(textlen + len + 2 > textsize){
+            textsize = 2*(textlen + len + 2);
+            text = (char*) realloc(text, textsize);
+         }
+         memcpy(text + textlen, line, len);
+         textlen += len;
+         text[textlen++] = '\n';
+      }
+      if(eof){
+         error = 1;
+         snprintf(msg, SCIP_MAXSTRLEN, "job not completed by instance/end");
+      }
+      if(!error){
+         fin = textlen > 0 ? fmemopen(text, textlen, "r") : NULL;
+         if(fin == NULL || !readInstance(fin, &(job->I))){
+            error = 1;
+            snprintf(msg, SCIP_MAXSTRLEN, "invalid instance");
+         }
+         if(fin != NULL)
+            fclose(fin);
+      }
+      if(error){
+         connError(conn, job->id, msg);
+         freeJob(job);
+         continue;
+      }
+      // the modes driven by files and the files written by the solve are not available to the clients
+      job->param.reopt_file = job->param.sweep_file = job->param.portfolio_file = job->param.write_lp = NULL;
+#ifdef DEBUG_SERVER
+      fprintf(stderr, "Server: job %s with n=%d nS=%d\n", job->id, job->I->n, job->I->nS);
+#endif
+      pthread_mutex_lock(&conn->lock);
+      conn->refs++;
+      pthread_mutex_unlock(&conn->lock);
+      queuePush(server, job);
+   }
+   free(line);
+   free(text);
+   connRelease(conn);
+   return NULL;
+}
+
+static void serverReply(serverJobT* job, SCIP_RETCODE retcode, mochilaResultT* result)
+{
+   serverConnT* conn = job->conn;
+   int i;
+
+   pthread_mutex_lock(&conn->lock);
+   if(retcode != SCIP_OKAY)
+      fprintf(conn->out, "error %s solver error %d\n", job->id, retcode);
+   else{
+      fprintf(conn->out, "result %s %d %lf %lf %lf %lf %lld %d", job->id, result->status, result->primal, result->dual,
+         result->gap, result->time, result->nodes, result->nitems);
+      for(i=0;i<result->nitems;i++)
+         fprintf(conn->out, " %d", result->items[i] + 1);
+      fprintf(conn->out, "\n");
+   }
+   fflush(conn->out);
+   pthread_mutex_unlock(&conn->lock);
+}
+
+// creates the warm SCIP of a worker (NULL if it fails: the jobs are solved in new SCIPs)
+static SCIP* workerScip(parametersT* param)
+{
+   SCIP* scip = NULL;
+
+   if(configScip(&scip, param) != SCIP_OKAY)
+      return NULL;
+   SCIPsetMessagehdlrQuiet(scip, TRUE);
+   return scip;
+}
+
+static void* serverWorker(void* arg)
+{
+   serverT* server = (serverT*) arg;
+   serverConnT* conn;
+   serverJobT* job;
+   SCIP* scip;
+   parametersT param;   /* the plugins of scip keep this pointer */
+   mochilaResultT result;
+   SCIP_RETCODE retcode;
+
+   param = *(server->param);
+   scip = workerScip(&param);
+   while((job = queuePop(server)) != NULL){
+      if(scip != NULL && !job->param.core && mochilaSamePlugins(&param, &job->param)){
+         param = job->param;
+         retcode = mochilaSolveIn(scip, job->I, &param, &result);
+         if(retcode != SCIP_OKAY){
+            // the state of scip is not known after an error
+            (void) SCIPfree(&scip);
+            param = *(server->param);
+            scip = workerScip(&param);
+         }
+      }
+      else
+         retcode = mochilaSolve(job->I, &job->param, &result);
+      serverReply(job, retcode, &result);
+      mochilaFreeResult(&result);
+      conn = job->conn;
+      freeJob(job);
+      connRelease(conn);
+   }
+   if(scip != NULL)
+      (void) SCIPfree(&scip);
+   return NULL;
+}
+
+SCIP_RETCODE serverRun(char* program, char* address, parametersT* param)
+{
+   serverT server;
+   serverReaderT* reader;
+   serverConnT* conn;
+   pthread_t* workers, thread;
+   struct sockaddr_un addr;
+   struct stat st;
+   FILE* in, *out;
+   int nworkers, t, fd, client;
+   SCIP_RETCODE retcode = SCIP_OKAY;
+
+   nworkers = param->server_workers > 0 ? param->server_workers : (int) sysconf(_SC_NPROCESSORS_ONLN);
+   if(nworkers < 1)
+      nworkers = 1;
+   param->reopt_file = param->sweep_file = param->portfolio_file = param->write_lp = NULL;
+   memset(&server, 0, sizeof(serverT));
+   server.param = param;
+   server.capacity = 2*nworkers;
+   server.jobs = (serverJobT**) malloc(sizeof(serverJobT*)*server.capacity);
+   pthread_mutex_init(&server.lock, NULL);
+   pthread_cond_init(&server.notempty, NULL);
+   pthread_cond_init(&server.notfull, NULL);
+   // a client that closes its connection must not kill the server
+   signal(SIGPIPE, SIG_IGN);
+
+   workers = (pthread_t*) malloc(sizeof(pthread_t)*nworkers);
+   for(t=0;t<nworkers;t++)
+      pthread_create(&workers[t], NULL, serverWorker, &server);
+
+   if(!strcmp(address, "-")){
+      // the answers go to the original stdout; everything else printed by the solver goes to stderr
+      out = fdopen(dup(STDOUT_FILENO), "w");
+      fflush(stdout);
+      dup2(STDERR_FILENO, STDOUT_FILENO);
+      fprintf(stderr, "%s: serving stdin with %d workers\n", program, nworkers);
+      reader = (serverReaderT*) malloc(sizeof(serverReaderT));
+      reader->server = &server;
+      reader->conn = connCreate(stdin, out, 0);
+      (void) serverReader(reader);
+   }
+   else{
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      if(fd < 0 || strlen(address) >= sizeof(addr.sun_path)){
+         fprintf(stderr, "%s: invalid socket %s\n", program, address);
+         retcode = SCIP_ERROR;
+      }
+      // only a socket left by a previous server is removed, never a file given by mistake
+      else if(lstat(address, &st) == 0 && !S_ISSOCK(st.st_mode)){
+         fprintf(stderr, "%s: %s exists and is not a socket\n", program, address);
+         retcode = SCIP_ERROR;
+      }
+      else{
+         strcpy(addr.sun_path, address);
+         unlink(address);
+         if(bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0 || listen(fd, 16) < 0){
+            perror(address);
+            retcode = SCIP_ERROR;
+         }
+      }
+      if(retcode == SCIP_OKAY)
+         fprintf(stderr, "%s: listening on %s with %d workers\n", program, address, nworkers);
+      while(retcode == SCIP_OKAY){
+         client = accept(fd, NULL, NULL);
+         if(client < 0){
+            if(errno == EINTR)
+               continue;
+            perror("accept");
+            retcode = SCIP_ERROR;
+            break;
+         }
+         in = fdopen(client, "r");
+         out = fdopen(dup(client), "w");
+         if(in == NULL || out == NULL){
+            if(in != NULL) fclose(in); else close(client);
+            if(out != NULL) fclose(out);
+            continue;
+         }
+         conn = connCreate(in, out, 1);
+         reader = (serverReaderT*) malloc(sizeof(serverReaderT));
+         reader->server = &server;
+         reader->conn = conn;
+         if(pthread_create(&thread, NULL, serverReader, reader) != 0){
+            free(reader);
+            connRelease(conn);
+            continue;
+         }
+         pthread_detach(thread);
+      }
+      if(fd >= 0)
+         close(fd);
+   }
+
+   // the workers solve the jobs still in the queue and stop
+   pthread_mutex_lock(&server.lock);
+   server.stop = 1;
+   pthread_cond_broadcast(&server.notempty);
+   pthread_mutex_unlock(&server.lock);
+   for(t=0;t<nworkers;t++)
+      pthread_join(workers[t], NULL);
+   free(workers);
+   free(server.jobs);
+   pthread_cond_destroy(&server.notfull);
+   pthread_cond_destroy(&server.notempty);
+   pthread_mutex_destroy(&server.lock);
+   return retcode;
+}
@@ -0,0 +1,30 @@
+/**@file   server_mochila.h
+ * @brief  server mode: a long-lived process that solves the instances sent by the clients
+ *
+ * Usage: mochila --server <socket path | -> [<parameters-setting>]. The address is a Unix socket (one client by
+ * connection, several connections at the same time) or "-" for stdin/stdout. The parameters of the command line are
+ * the defaults of all jobs. Each request is
+ *
+ *    job <id>
+ *    --option value ...          (zero or more lines, as in the command line)
+ *    instance
+ *    <instance in the format of the instance files>
+ *    end
+ *
+ * and "quit" closes the connection. Each job is answered, in the order of finish, by one line
+ *
+ *    result <id> <status> <primal> <dual> <gap> <time> <nodes> <nitems> <items 1..n>
+ *
+ * or "error <id> <message>". The jobs are solved by --server_workers solvers (default: one by processor), each one
+ * with a SCIP whose plugins are included once and reused by all jobs with the same plugins; the other jobs are solved
+ * in a new SCIP. At most two jobs by solver wait in the queue: the reading of the connections stops when it is full.
+ * The options --reopt, --sweep, --portfolio and --write_lp are ignored in the jobs.
+ **/
+#ifndef __SERVER_MOCHILA__
+#define __SERVER_MOCHILA__
+#include "scip/scip.h"
+#include "parameters_mochila.h"
+
+// serves the clients at address with the default parameters param. Returns only for "-" (at the end of stdin)
+SCIP_RETCODE serverRun(char* program, char* address, parametersT* param);
+#endif
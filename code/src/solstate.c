@@ -0,0 +1,151 @@
+/**@file   solstate.c
+ * @brief  solution of the knapsack with forfeit sets with incremental evaluation of moves
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include "solstate.h"
+
+void solstateCreate(solstateT** S, instanceT* I)
+{
+   *S = (solstateT*) malloc(sizeof(solstateT));
+   (*S)->I = I;
+   (*S)->x = (int*) calloc(I->n, sizeof(int));
+   (*S)->count = (int*) calloc(I->nS, sizeof(int));
+   (*S)->nitems = 0;
+   (*S)->weight = 0;
+   (*S)->value = 0;
+   (*S)->violations = 0;
+}
+void solstateFree(solstateT** S)
+{
+   if(*S){
+      free((*S)->x);
+      free((*S)->count);
+      free(*S);
+      *S = NULL;
+   }
+}
+void solstateClear(solstateT* S)
+{
+   memset(S->x, 0, sizeof(int)*S->I->n);
+   memset(S->count, 0, sizeof(int)*S->I->nS);
+   S->nitems = 0;
+   S->weight = 0;
+   S->value = 0;
+   S->violations = 0;
+}
+void solstateLoad(solstateT* S, int* x)
+{
+   int i;
+
+   solstateClear(S);
+   for(i=0;i<S->I->n;i++){
+      if(x[i])
+         solstateAdd(S, i);
+   }
+}
+void solstateCopy(solstateT* target, solstateT* source)
+{
+   memcpy(target->x, source->x, sizeof(int)*source->I->n);
+   memcpy(target->count, source->count, sizeof(int)*source->I->nS);
+   target->nitems = source->nitems;
+   target->weight = source->weight;
+   target->value = source->value;
+   target->violations = source->violations;
+}
+int solstateDeltaAdd(solstateT* S, int i, int* dviol)
+{
+   int j, s, delta, viol;
+
+   delta = S->I->item[i].value;
+   viol = 0;
+   for(s=0;s<S->I->item[i].nsets;s++){
+      j = S->I->item[i].set[s];
+      // the set already has h_j items: one more violation
+      if(S->count[j] >= S->I->S[j].h){
+         delta -= S->I->S[j].d;
+         viol++;
+      }
+   }
+   if(dviol)
+      *dviol = viol;
+   return delta;
+}
+int solstateDeltaRemove(solstateT* S, int i, int* dviol)
+{
+   int j, s, delta, viol;
+
+   delta = -S->I->item[i].value;
+   viol = 0;
+   for(s=0;s<S->I->item[i].nsets;s++){
+      j = S->I->item[i].set[s];
+      if(S->count[j] > S->I->S[j].h){
+         delta += S->I->S[j].d;
+         viol--;
+      }
+   }
+   if(dviol)
+      *dviol = viol;
+   return delta;
+}
+int solstateCanAdd(solstateT* S, int i)
+{
+   int dviol;
+
+   if(S->x[i] || S->weight + S->I->item[i].weight > S->I->C)
+      return 0;
+   solstateDeltaAdd(S, i, &dviol);
+   return S->violations + dviol <= S->I->k;
+}
+void solstateAdd(solstateT* S, int i)
+{
+   int s, dviol;
+
+   S->value += solstateDeltaAdd(S, i, &dviol);
+   S->violations += dviol;
+   S->weight += S->I->item[i].weight;
+   S->nitems++;
+   S->x[i] = 1;
+   for(s=0;s<S->I->item[i].nsets;s++)
+      S->count[S->I->item[i].set[s]]++;
+}
+void solstateRemove(solstateT* S, int i)
+{
+   int s, dviol;
+
+   S->value += solstateDeltaRemove(S, i, &dviol);
+   S->violations += dviol;
+   S->weight -= S->I->item[i].weight;
+   S->nitems--;
+   S->x[i] = 0;
+   for(s=0;s<S->I->item[i].nsets;s++)
+      S->count[S->I->item[i].set[s]]--;
+}
+int solstateFeasible(solstateT* S)
+{
+   return S->weight <= S->I->C && S->violations <= S->I->k;
+}
+void solstateRepair(solstateT* S)
+{
+   double ratio, best;
+   int i, bi;
+
+   while(!solstateFeasible(S)){
+      bi = -1;
+      best = 0.0;
+      for(i=0;i<S->I->n;i++){
+         if(!S->x[i])
+            continue;
+         // any item releases violations when k is exceeded
+         ratio = -solstateDeltaRemove(S, i, NULL)/(double) (S->I->item[i].weight > 0 ? S->I->item[i].weight : 1);
+         if(bi < 0 || ratio < best){
+            best = ratio;
+            bi = i;
+         }
+      }
+      if(bi < 0)
+         break;
+      solstateRemove(S, bi);
+   }
+}
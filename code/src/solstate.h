@@ -0,0 +1,40 @@
+/**@file   solstate.h
+ * @brief  solution of the knapsack with forfeit sets with incremental evaluation of moves
+ *
+ * It keeps the total of selected items of each forfeit set, so the change in the objective value when an item is
+ * added or removed only looks at the forfeit sets of that item.
+ **/
+#ifndef __SOLSTATE__
+#define __SOLSTATE__
+#include "problem.h"
+
+typedef struct{
+   instanceT* I;      /**< instance */
+   int* x;            /**< x[i]=1 if item i is selected */
+   int* count;        /**< total of selected items in each forfeit set */
+   int nitems;        /**< total of selected items */
+   int weight;        /**< total weight of selected items */
+   int value;         /**< objective value: values of selected items minus forfeit costs */
+   int violations;    /**< total of violations: sum of max(0, count_j - h_j) */
+} solstateT;
+
+void solstateCreate(solstateT** S, instanceT* I);
+void solstateFree(solstateT** S);
+// remove all items
+void solstateClear(solstateT* S);
+// load the items of x (x[i]=1 if item i is selected)
+void solstateLoad(solstateT* S, int* x);
+void solstateCopy(solstateT* target, solstateT* source);
+// change in the objective value (and in the violations, if dviol != NULL) if item i is added
+int solstateDeltaAdd(solstateT* S, int i, int* dviol);
+// change in the objective value (and in the violations, if dviol != NULL) if item i is removed
+int solstateDeltaRemove(solstateT* S, int i, int* dviol);
+// check if item i can be added without exceeding the capacity or the forfeit limit k
+int solstateCanAdd(solstateT* S, int i);
+void solstateAdd(solstateT* S, int i);
+void solstateRemove(solstateT* S, int i);
+// check if the capacity and the forfeit limit k are respected
+int solstateFeasible(solstateT* S);
+// removes the items with the smallest loss of value by weight until the solution is feasible
+void solstateRepair(solstateT* S);
+#endif
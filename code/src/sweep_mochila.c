@@ -0,0 +1,209 @@
+/**@file   sweep_mochila.c
+ * @brief  parametric sweep over pairs (C,k) of capacity and limit of violations
+ **/
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<pthread.h>
+#include "sweep_mochila.h"
+#include "probdata_mochila.h"
+#include "solstate.h"
+#include "utils.h"
+
+//#define DEBUG_SWEEP 1
+
+/** one point of the sweep and its result */
+typedef struct{
+   int C;
+   int k;
+   int status;        /**< SCIP status (-1: not solved, -2: no thread could load the problem) */
+   double primal;
+   double dual;
+   double gap;
+   double time;
+   long long nodes;
+   int nitems;        /**< items in the best solution */
+   int start;         /**< 1 if the start solution was accepted */
+} sweepPointT;
+
+/** data shared by the threads */
+typedef struct{
+   instanceT* I;
+   parametersT* param;
+   sweepPointT* points;
+   int npoints;
+   int next;          /**< next point to solve */
+   int nfailed;       /**< threads that could not load the problem */
+   pthread_mutex_t lock;
+} sweepDataT;
+
+/** reads the pairs (C,k). Returns the total of points */
+static int readPoints(char* filename, sweepPointT** points)
+{
+   FILE* fin;
+   char line[200];
+   int n, size, C, k;
+
+   fin = fopen(filename, "r");
+   if(!fin){
+      printf("\nProblem to open sweep file %s\n", filename);
+      return 0;
+   }
+   n = size = 0;
+   *points = NULL;
+   while(fgets(line, sizeof(line), fin)){
+      if(line[0] == '#' || sscanf(line, "%d %d", &C, &k) != 2)
+         continue;
+      if(n == size){
+         size = 2*size + 8;
+         *points = (sweepPointT*) realloc(*points, sizeof(sweepPointT)*size);
+      }
+      (*points)[n].C = C;
+      (*points)[n].k = k;
+      (*points)[n].status = -1;
+      n++;
+   }
+   fclose(fin);
+   return n;
+}
+
+/** solves the point p in the model of the thread, starting from the solution x (updated with the new solution) */
+static SCIP_RETCODE solvePoint(SCIP* scip, instanceT* I, sweepPointT* p, int* x, int hasx)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_CONS** conss;
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   solstateT* S;
+   int i;
+
+   if(SCIPgetStage(scip) != SCIP_STAGE_PROBLEM){
+      SCIP_CALL( SCIPfreeTransform(scip) );
+   }
+   // only the capacity and the maxViolations rows change
+   probdata = SCIPgetProbData(scip);
+   conss = SCIPprobdataGetConss(probdata);
+   I->C = p->C;
+   I->k = p->k;
+   SCIP_CALL( SCIPchgRhsLinear(scip, conss[0], (SCIP_Real) I->C) );
+   SCIP_CALL( SCIPchgRhsLinear(scip, conss[1+I->nS], (SCIP_Real) I->k) );
+   p->start = 0;
+   if(hasx){
+      solstateCreate(&S, I);
+      solstateLoad(S, x);
+      solstateRepair(S);
+      SCIP_CALL( createSolFromItems(scip, NULL, S->x, &sol) );
+      SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      p->start = stored ? 1 : 0;
+      solstateFree(&S);
+   }
+   SCIP_CALL( SCIPsolve(scip) );
+   p->status = SCIPgetStatus(scip);
+   p->primal = SCIPgetPrimalbound(scip);
+   p->dual = SCIPgetDualbound(scip);
+   p->gap = SCIPgetGap(scip);
+   p->time = SCIPgetSolvingTime(scip);
+   p->nodes = SCIPgetNTotalNodes(scip);
+   p->nitems = 0;
+   if(SCIPgetBestSol(scip) != NULL){
+      vars = SCIPprobdataGetVars(SCIPgetProbData(scip));
+      for(i=0;i<I->n;i++){
+         x[i] = (int) (SCIPgetSolVal(scip, SCIPgetBestSol(scip), vars[i]) + 0.5);
+         p->nitems += x[i];
+      }
+   }
+   return SCIP_OKAY;
+}
+
+/** thread: takes the next point until all of them are solved */
+static void* sweepThread(void* arg)
+{
+   sweepDataT* data;
+   instanceT* I;
+   SCIP* scip;
+   int t, hasx, *x;
+
+   data = (sweepDataT*) arg;
+   // the instance is changed by the thread (C and k), so each one has its own copy
+   copyInstance(data->I, &I);
+   configScip(&scip, data->param);
+   SCIP_CALL_ABORT( SCIPsetIntParam(scip, "display/verblevel", 0) );
+   if(!loadProblem(scip, "sweep", I, 0, NULL, data->param)){
+      printf("\nProblem to load instance problem\n");
+      SCIP_CALL_ABORT( SCIPfree(&scip) );
+      freeInstance(I);
+      pthread_mutex_lock(&data->lock);
+      data->nfailed++;
+      pthread_mutex_unlock(&data->lock);
+      return NULL;
+   }
+   x = (int*) calloc(I->n, sizeof(int));
+   hasx = 0;
+   for(;;){
+      pthread_mutex_lock(&data->lock);
+      t = data->next++;
+      pthread_mutex_unlock(&data->lock);
+      if(t >= data->npoints)
+         break;
+      SCIP_CALL_ABORT( solvePoint(scip, I, &data->points[t], x, hasx) );
+      hasx = SCIPgetBestSol(scip) != NULL;
+#ifdef DEBUG_SWEEP
+      printf("\nSweep: C=%d k=%d z=%lf", data->points[t].C, data->points[t].k, data->points[t].primal);
+#endif
+   }
+   free(x);
+   SCIP_CALL_ABORT( SCIPfree(&scip) );
+   freeInstance(I);
+   return NULL;
+}
+
+SCIP_RETCODE sweepSolve(instanceT* I, parametersT* param, char* sweepfile, char* outputname)
+{
+   sweepDataT data;
+   pthread_t* threads;
+   FILE* fout;
+   char filename[SCIP_MAXSTRLEN];
+   int t, nthreads;
+
+   data.npoints = readPoints(sweepfile, &data.points);
+   if(data.npoints == 0)
+      return SCIP_READERROR;
+   data.I = I;
+   data.param = param;
+   data.next = 0;
+   data.nfailed = 0;
+   pthread_mutex_init(&data.lock, NULL);
+   nthreads = param->sweep_threads < data.npoints ? param->sweep_threads : data.npoints;
+   threads = (pthread_t*) malloc(sizeof(pthread_t)*nthreads);
+   for(t=0;t<nthreads;t++)
+      pthread_create(&threads[t], NULL, sweepThread, &data);
+   for(t=0;t<nthreads;t++)
+      pthread_join(threads[t], NULL);
+   pthread_mutex_destroy(&data.lock);
+   free(threads);
+   // the points left by the threads that failed are marked in the table
+   if(data.nfailed > 0){
+      for(t=data.next;t<data.npoints;t++)
+         data.points[t].status = -2;
+      printf("\nSweep: %d of %d threads could not load the problem, %d points not solved\n", data.nfailed, nthreads,
+         data.next < data.npoints ? data.npoints - data.next : 0);
+   }
+
+   // consolidated table of results
+   (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s.sweep", outputname);
+   fout = fopen(filename, "w");
+   if(!fout){
+      printf("\nProblem to create file %s\n", filename);
+      free(data.points);
+      return SCIP_NOFILE;
+   }
+   fprintf(fout, "C;k;status;primal;dual;gap;time;nodes;items;start;%s\n", param->parameter_stamp);
+   for(t=0;t<data.npoints;t++){
+      fprintf(fout, "%d;%d;%d;%lf;%lf;%lf;%lf;%lld;%d;%d\n", data.points[t].C, data.points[t].k, data.points[t].status, data.points[t].primal, data.points[t].dual, data.points[t].gap, data.points[t].time, data.points[t].nodes, data.points[t].nitems, data.points[t].start);
+   }
+   fclose(fout);
+   printf("\nSweep: %d points solved with %d threads, results in %s\n", data.npoints, nthreads, filename);
+   free(data.points);
+   return SCIP_OKAY;
+}
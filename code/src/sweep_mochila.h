@@ -0,0 +1,17 @@
+/**@file   sweep_mochila.h
+ * @brief  parametric sweep over pairs (C,k) of capacity and limit of violations
+ *
+ * The sweep file has one pair "C k" by line (lines starting with # are comments). The instance is loaded once; each
+ * thread has its own copy of the instance and its own SCIP model, where only the right hand sides of the capacity
+ * and maxViolations rows are changed between points. Each solve starts from the previous solution of the thread,
+ * repaired for the new (C,k). The results are written in one table, <output>.sweep.
+ **/
+#ifndef __SWEEP_MOCHILA__
+#define __SWEEP_MOCHILA__
+#include "scip/scip.h"
+#include "problem.h"
+#include "parameters_mochila.h"
+
+// solves the instance I for each pair (C,k) of the sweep file with param->sweep_threads threads
+SCIP_RETCODE sweepSolve(instanceT* I, parametersT* param, char* sweepfile, char* outputname);
+#endif
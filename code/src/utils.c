@@ -1,4 +1,5 @@
 #include <time.h>
+#include <string.h>
 #include "utils.h"
 //
 SCIP_RETCODE SCIPtrySolMine(SCIP* scip, SCIP_SOL* sol, SCIP_Bool printreason, SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows, SCIP_Bool *stored)
@@ -10,7 +11,7 @@ SCIP_RETCODE SCIPtrySolMine(SCIP* scip, SCIP_SOL* sol, SCIP_Bool printreason, SC
 #endif
 }
 //
-SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname)
+SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname, const phaseTimesT* phases)
 {
   SCIP_Bool outputorigsol = TRUE;
   SCIP_SOL* bestSolution = NULL;
@@ -18,8 +19,16 @@ SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname)
   char filename[SCIP_MAXSTRLEN];
   FILE* fout;
   SCIP_HEUR* heur_hdlr;
+  SCIP_CONSHDLR* cons_hdlr;
+  SCIP_PROP* prop_hdlr;
+  SCIP_SEPA* sepa_hdlr;
+  SCIP_BRANCHRULE* branch_hdlr;
+  SCIP_Longint nglobal, nlocal;
+  timelineSummaryT timeline;
   instanceT* I;
   const parametersT* param;
+  FILE* fprofile;
+  int p;
 
   sprintf(filename, "%s.out", outputname);
   fout = fopen(filename,"w");
@@ -77,6 +86,64 @@ SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname)
        heur_hdlr = SCIPfindHeur(scip, "lns");
        fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPheurGetTime(heur_hdlr),SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
     }
+    if(param->heur_pr){
+       heur_hdlr = SCIPfindHeur(scip, "pr");
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPheurGetTime(heur_hdlr),SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+    }
+    if(param->heur_rins){
+       heur_hdlr = SCIPfindHeur(scip, "rins");
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPheurGetTime(heur_hdlr),SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+    }
+    if(param->heur_lb){
+       heur_hdlr = SCIPfindHeur(scip, "lb");
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPheurGetTime(heur_hdlr),SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+    }
+    // columns of the plugins added after the heuristics, appended so the layout of the old .out files is kept
+    if(param->cons_forfeit){
+       cons_hdlr = SCIPfindConshdlr(scip, "forfeit");
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPconshdlrGetPropTime(cons_hdlr),SCIPconshdlrGetNPropCalls(cons_hdlr), SCIPconshdlrGetNDomredsFound(cons_hdlr), SCIPconshdlrGetNCutoffs(cons_hdlr), SCIPconshdlrGetName(cons_hdlr));
+    }
+    if(param->prop_redcost){
+       prop_hdlr = SCIPfindProp(scip, "redcostmochila");
+       SCIPpropRedcostGetNReductions(scip, &nglobal, &nlocal);
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPpropGetTime(prop_hdlr),SCIPpropGetNCalls(prop_hdlr), nglobal, nlocal, SCIPpropGetName(prop_hdlr));
+    }
+    if(param->sepa_forfeit){
+       sepa_hdlr = SCIPfindSepa(scip, "forfeit");
+       fprintf(fout, ";%lf;%lld;%lld;%lld;%s",SCIPsepaGetTime(sepa_hdlr),SCIPsepaGetNCalls(sepa_hdlr), SCIPsepaGetNCutsFound(sepa_hdlr), SCIPsepaGetNCutsApplied(sepa_hdlr), SCIPsepaGetName(sepa_hdlr));
+    }
+    if(param->branch_forfeit){
+       branch_hdlr = SCIPfindBranchrule(scip, "forfeit");
+       fprintf(fout, ";%lf;%lld;%lld;%s",SCIPbranchruleGetTime(branch_hdlr),SCIPbranchruleGetNLPCalls(branch_hdlr), SCIPbranchruleGetNChildren(branch_hdlr), SCIPbranchruleGetName(branch_hdlr));
+    }
+    if(param->timeline){
+       SCIP_CALL( SCIPeventhdlrTimelineWrite(scip, outputname) );
+       (void) SCIPeventhdlrTimelineGetSummary(scip, &timeline);
+       fprintf(fout, ";%lf;%lf;%lf;%d;timeline", timeline.primalintegral, timeline.firstsol, timeline.timetotarget, timeline.npoints);
+    }
+    // phases of the calls of the heuristics (the transformed problem has the profiles of the solve)
+    if(param->heur_profile){
+       sprintf(filename, "%s.profile", outputname);
+       fprofile = fopen(filename, "w");
+       if(fprofile != NULL){
+          fprintf(fprofile, "heur;phase;calls;total;mean;p50;p95;max\n");
+          if(param->heur_aleatoria)
+             profileWrite(fprofile, SCIPprobdataGetProfile(probdata, PROFILE_ALEATORIA));
+          if(param->heur_rf)
+             profileWrite(fprofile, SCIPprobdataGetProfile(probdata, PROFILE_RF));
+          if(param->heur_lns)
+             profileWrite(fprofile, SCIPprobdataGetProfile(probdata, PROFILE_LNS));
+          fclose(fprofile);
+       }
+       else
+          printf("\nProblem to create file %s\n", filename);
+    }
+    // wall and CPU times of the phases of the run until the solve (the output is in progress) and peak RSS
+    if(phases != NULL){
+       for(p=0;p<PHASE_OUTPUT;p++)
+          fprintf(fout, ";%lf;%lf", phases->wall[p], phases->cpu[p]);
+       fprintf(fout, ";%ld;phases", peakRSS());
+    }
     
     fprintf(fout, ";%s\n", param->parameter_stamp);
   }
@@ -112,6 +179,28 @@ SCIP_RETCODE configScip(
    SCIP_CALL( SCIPsetRealParam(scip, "limits/time", param->time_limit) );
    // for only root, use 1
    SCIP_CALL( SCIPsetLongintParam(scip, "limits/nodes", param->nodes_limit) );
+   /* concurrent solve: each thread solves a copy of the problem (with copies of our plugins) with other settings */
+   if(param->threads > 1){
+      SCIP_CALL( SCIPsetIntParam(scip, "parallel/minnthreads", param->threads) );
+      SCIP_CALL( SCIPsetIntParam(scip, "parallel/maxnthreads", param->threads) );
+   }
+   if(param->cons_forfeit)
+      SCIP_CALL( SCIPincludeConshdlrForfeit(scip) );
+
+   /* reduced cost fixing of the items and of the violations */
+   if(param->prop_redcost){
+      SCIP_CALL( SCIPsetIntParam(scip, "propagating/redcost/freq", -1) );
+      SCIP_CALL( SCIPincludePropRedcostMochila(scip, param) );
+   }
+
+   /* problem specific cuts (included after SCIPsetSeparating(), so they are not turned off) */
+   if(param->sepa_forfeit)
+      SCIP_CALL( SCIPincludeSepaForfeit(scip, param) );
+
+   /* branching on the forfeit structure, pscost on x is the fallback */
+   if(param->branch_forfeit)
+      SCIP_CALL( SCIPincludeBranchruleForfeit(scip, param) );
+
    if(param->heur_aleatoria)
       SCIP_CALL( SCIPincludeHeurAleatoria(scip, param) );
    
@@ -121,56 +210,172 @@ SCIP_RETCODE configScip(
    if(param->heur_lns)
       SCIP_CALL( SCIPincludeHeurLns(scip, param) );
 
+   if(param->pool_size > 0)
+      SCIP_CALL( SCIPincludeEventhdlrElitePool(scip, param) );
+
+   if(param->heur_pr)
+      SCIP_CALL( SCIPincludeHeurPr(scip, param) );
+
+   if(param->heur_rins)
+      SCIP_CALL( SCIPincludeHeurRins(scip, param) );
+
+   if(param->heur_lb)
+      SCIP_CALL( SCIPincludeHeurLb(scip, param) );
+
+   /* trajectory of the bounds, primal integral and time to target */
+   if(param->timeline)
+      SCIP_CALL( SCIPincludeEventhdlrTimeline(scip, param) );
+
    *pscip = scip;
    return SCIP_OKAY;
 }
-/**
- * set default+user parameters
- **/
-int setParameters(int argc, char** argv, parametersT* param)
+/** settings of each parameter: name, range and default value of a field of parametersT */
+typedef struct{
+  const char* description;
+  const char* param_name;
+  void* param_var;
+  enum {INT, DOUBLE, STRING} type;
+  int ilb;
+  int iub;
+  double dlb;
+  double dub;
+  int idefault;
+  double ddefault;    
+} settingsT;
+
+enum {time_limit,display_freq,nodes_limit,seed,write_lp,sol_stream,timeline,timeline_target,param_stamp, param_output_path, presolve, symmetry, reopt_file, reopt_scip, sweep_file, sweep_threads, portfolio_file, server_workers, threads, core, core_size, cons_forfeit, prop_redcost, sepa_forfeit, sepa_maxrounds, sepa_maxcuts, sepa_minefficacy, branch_forfeit, heur_freq, heur_maxdepth, heur_freqofs,heur_profile,heur_rf, rf_perc, rf_time, heur_lns, lns_time, lns_perc, lns_dpmax, heur_aleatoria, aleatoria_mode, grasp_alpha, heur_pr, heur_rins, rins_minfix, rins_time, rins_poolsols, heur_lb, lb_radius, lb_time, pool_size, pool_mindist, total_parameters};
+
+/** fills the settings table, where param_var points to the fields of param */
+static void getSettings(parametersT* param, settingsT* parameters)
 {
-  typedef struct{
-    const char* description;
-    const char* param_name;
-    void* param_var;
-    enum {INT, DOUBLE, STRING} type;
-    int ilb;
-    int iub;
-    double dlb;
-    double dub;
-    int idefault;
-    double ddefault;    
-  } settingsT;
-
-  enum {time_limit,display_freq,nodes_limit,param_stamp, param_output_path, heur_freq, heur_maxdepth, heur_freqofs,heur_rf, rf_perc, rf_time, heur_lns, lns_time, lns_perc, heur_aleatoria, total_parameters};
-
-  settingsT parameters[]={
+  settingsT table[]={
             {"time limit", "--time", &(param->time_limit), INT, 0, 7200, 0,0,1800,0},
             {"display freq", "--display", &(param->display_freq), INT, -1, MAXINT, 0,0,50,0},
             {"nodes limit", "--nodes", &(param->nodes_limit), INT, -1, MAXINT, 0,0,-1,0},
-            {"param stamp", "--param_stamp", &(param->parameter_stamp), STRING, 0,0,0,0,0,0},
+            {"seed", "--seed", &(param->seed), INT, -1,MAXINT,0,0,-1,0},
+          {"write lp", "--write_lp", &(param->write_lp), STRING, 0,0,0,0,0,0},
+            {"sol stream", "--sol_stream", &(param->sol_stream), INT, 0,1,0,0,0,0},
+            {"timeline", "--timeline", &(param->timeline), INT, 0,1,0,0,0,0},
+            {"timeline target", "--timeline_target", &(param->timeline_target), DOUBLE, 0,0,0,1.0,0,0.01},
+          {"param stamp", "--param_stamp", &(param->parameter_stamp), STRING, 0,0,0,0,0,0},
             {"output path", "--output_path", &(param->output_path), STRING, 0,0,0,0,0,0},
+            {"presolve", "--presolve", &(param->presolve), INT, 0,1,0,0,0,0},
+            {"symmetry", "--symmetry", &(param->symmetry), INT, 0,1,0,0,0,0},
+            {"reopt delta file", "--reopt", &(param->reopt_file), STRING, 0,0,0,0,0,0},
+            {"reopt scip", "--reopt_scip", &(param->reopt_scip), INT, 0,1,0,0,1,0},
+            {"sweep file", "--sweep", &(param->sweep_file), STRING, 0,0,0,0,0,0},
+            {"sweep threads", "--sweep_threads", &(param->sweep_threads), INT, 1,64,0,0,1,0},
+            {"portfolio file", "--portfolio", &(param->portfolio_file), STRING, 0,0,0,0,0,0},
+            {"server workers", "--server_workers", &(param->server_workers), INT, 0,256,0,0,0,0},
+            {"threads", "--threads", &(param->threads), INT, 1,64,0,0,1,0},
+            {"core", "--core", &(param->core), INT, 0,1,0,0,0,0},
+            {"core size", "--core_size", &(param->core_size), INT, 1,1000000,0,0,100,0},
+            {"cons forfeit", "--cons_forfeit", &(param->cons_forfeit), INT, 0,1,0,0,0,0},
+            {"prop redcost", "--prop_redcost", &(param->prop_redcost), INT, 0,1,0,0,0,0},
+            {"sepa forfeit", "--sepa_forfeit", &(param->sepa_forfeit), INT, 0,1,0,0,0,0},
+            {"sepa maxrounds", "--sepa_maxrounds", &(param->sepa_maxrounds), INT, -1,MAXINT,0,0,5,0},
+            {"sepa maxcuts", "--sepa_maxcuts", &(param->sepa_maxcuts), INT, 1,MAXINT,0,0,50,0},
+            {"sepa minefficacy", "--sepa_minefficacy", &(param->sepa_minefficacy), DOUBLE, 0,0,0,1.0,0,0.01},
+            {"branch forfeit", "--branch_forfeit", &(param->branch_forfeit), INT, 0,1,0,0,0,0},
             {"heur_freq", "--heur_freq", &(param->heur_freq), INT, 0,10,0,0,1,0},
             {"heur_maxdepth", "--heur_maxdepth", &(param->heur_maxdepth), INT, -1,10,0,0,-1,0},
             {"heur_freqofs", "--heur_freqofs", &(param->heur_freqofs), INT, 0,10,0,0,0,0},
+            {"heur profile", "--heur_profile", &(param->heur_profile), INT, 0,1,0,0,0,0},
             {"heur_rf", "--heur_rf", &(param->heur_rf), INT, 0,3,0,0,0,0},
             {"rf perc", "--rf_perc", &(param->rf_perc), DOUBLE, 0,0,0,1.0,0,0.3},
             {"rf_time", "--rf_time", &(param->rf_time), INT, 0, 3600, 0,0,30,0},
             {"heur lns", "--heur_lns", &(param->heur_lns), INT, 0,1,0,0,0,0},
             {"lns perc", "--lns_perc", &(param->lns_perc), DOUBLE, 0,0,0,1.0,0,0.3},
             {"lns_time", "--lns_time", &(param->lns_time), INT, 0, 3600, 0,0,30,0},
-            {"heur aleatoria", "--heur_aleatoria", &(param->heur_aleatoria), INT, 0,1,0,0,0,0}
+            {"lns dp max", "--lns_dpmax", &(param->lns_dpmax), INT, 0, 64, 0,0,0,0},
+            {"heur aleatoria", "--heur_aleatoria", &(param->heur_aleatoria), INT, 0,1,0,0,0,0},
+            {"aleatoria mode", "--aleatoria_mode", &(param->aleatoria_mode), INT, 0,2,0,0,0,0},
+            {"grasp alpha", "--grasp_alpha", &(param->grasp_alpha), DOUBLE, 0,0,0,1.0,0,0.2},
+            {"heur pr", "--heur_pr", &(param->heur_pr), INT, 0,1,0,0,0,0},
+            {"heur rins", "--heur_rins", &(param->heur_rins), INT, 0,1,0,0,0,0},
+            {"rins minfix", "--rins_minfix", &(param->rins_minfix), DOUBLE, 0,0,0,1.0,0,0.5},
+            {"rins_time", "--rins_time", &(param->rins_time), INT, 0, 3600, 0,0,30,0},
+            {"rins poolsols", "--rins_poolsols", &(param->rins_poolsols), INT, 0,100,0,0,3,0},
+            {"heur lb", "--heur_lb", &(param->heur_lb), INT, 0,1,0,0,0,0},
+            {"lb radius", "--lb_radius", &(param->lb_radius), INT, 2,MAXINT,0,0,10,0},
+            {"lb_time", "--lb_time", &(param->lb_time), INT, 0, 3600, 0,0,30,0},
+            {"pool size", "--pool_size", &(param->pool_size), INT, 0,100,0,0,0,0},
+            {"pool mindist", "--pool_mindist", &(param->pool_mindist), INT, 1,MAXINT,0,0,2,0}
   };
+
+  memcpy(parameters, table, sizeof(table));
+}
+
+/**
+ * set the default value of all parameters (no stamp file is written)
+ **/
+void defaultParameters(parametersT* param)
+{
+  settingsT parameters[total_parameters];
+  int i;
+
+  getSettings(param, parameters);
+  for(i=0;i<total_parameters;i++){
+    if(parameters[i].type==INT)
+      *((int*)(parameters[i].param_var)) = parameters[i].idefault;
+    else if (parameters[i].type==DOUBLE)
+      *((double*)(parameters[i].param_var)) = parameters[i].ddefault;
+    else
+      *((char**) (parameters[i].param_var)) = NULL;
+  }
+  param->output_path = ".";
+}
+
+/**
+ * set the value of one parameter (name as in the command line). STRING values are not copied.
+ * Returns 0 (ok), PARAM_INVALID (unknown name) or PARAM_OUTOFRANGE
+ **/
+int setParameterValue(parametersT* param, char* name, char* value)
+{
+  settingsT parameters[total_parameters];
+  int j, ivalue;
+  double dvalue;
+
+  getSettings(param, parameters);
+  for(j=0;j<total_parameters && strcmp(name,parameters[j].param_name);j++)
+    ;
+  if(j>=total_parameters)
+    return PARAM_INVALID;
+  switch(parameters[j].type){
+  case INT:
+    ivalue = atoi(value);
+    if(ivalue < parameters[j].ilb || ivalue > parameters[j].iub)
+      return PARAM_OUTOFRANGE;
+    *((int*)(parameters[j].param_var)) = ivalue;
+    break;
+  case DOUBLE:
+    dvalue = atof(value);
+    if(dvalue < parameters[j].dlb || dvalue > parameters[j].dub)
+      return PARAM_OUTOFRANGE;
+    *((double*)(parameters[j].param_var)) = dvalue;
+    break;
+  case STRING:
+    *((char**) (parameters[j].param_var)) = value;
+  }
+  return 0;
+}
+
+/**
+ * set default+user parameters
+ **/
+int setParameters(int argc, char** argv, parametersT* param)
+{
+  settingsT parameters[total_parameters];
   int i, j, ivalue, error;
   double dvalue;
   FILE *fin;
-  char* current_path = ".";
 
   // total_parameters = sizeof(parameters)/sizeof(parameters[0]);
   
   
   if (param==NULL)
     return 0;
+  getSettings(param, parameters);
   
   // check arguments
   if(argc<2){
@@ -205,52 +410,21 @@ int setParameters(int argc, char** argv, parametersT* param)
   fclose(fin);  
 
   // set default parameters value
-  for(i=0;i<total_parameters;i++){
-    if(parameters[i].type==INT)
-      *((int*)(parameters[i].param_var)) = parameters[i].idefault;
-    else if (parameters[i].type==DOUBLE)
-      *((double*)(parameters[i].param_var)) = parameters[i].ddefault;
-    else
-      *((char**) (parameters[i].param_var)) = NULL;
-  }
-  param->output_path = current_path;
+  defaultParameters(param);
 
   // set user parameters value
   error = 0;
   for(i=2;i<argc && !error;i+=2){
-    for(j=0;j<total_parameters && strcmp(argv[i],parameters[j].param_name);j++)
-      ;
-    if(j>=total_parameters || i==argc-1){
+    error = i==argc-1 ? PARAM_INVALID : setParameterValue(param, argv[i], argv[i+1]);
+    if(error == PARAM_INVALID)
       printf("\nParameter (%s) invalid or uncompleted.", argv[i]);
-      error = 1;
-    }
-    else{
-      switch(parameters[j].type){
-      case INT:
-        ivalue = atoi(argv[i+1]);
-        if(ivalue < parameters[j].ilb || ivalue > parameters[j].iub){
-          printf("\nParameter (%s) value (%d) out of range [%d,%d].", argv[i], ivalue, parameters[j].ilb, parameters[j].iub);
-          error = 1;
-          //          break;
-        }
-        else{
-          *((int*)(parameters[j].param_var)) = ivalue;          
-        }
-        break;
-      case DOUBLE:
-        dvalue = atof(argv[i+1]);
-        if(dvalue < parameters[j].dlb || dvalue > parameters[j].dub){
-          printf("\nParameter (%s) value (%lf) out of range [%lf,%lf].", argv[i], dvalue, parameters[j].dlb, parameters[j].dub);
-          error = 1;
-          //          break;
-        }
-        else{
-          *((double*)(parameters[j].param_var)) = dvalue;          
-        }
-        break;
-      case STRING:
-        *((char**) (parameters[j].param_var)) = argv[i+1];
-      }
+    else if(error == PARAM_OUTOFRANGE){
+      for(j=0;strcmp(argv[i],parameters[j].param_name);j++)
+        ;
+      if(parameters[j].type==INT)
+        printf("\nParameter (%s) value (%d) out of range [%d,%d].", argv[i], atoi(argv[i+1]), parameters[j].ilb, parameters[j].iub);
+      else
+        printf("\nParameter (%s) value (%lf) out of range [%lf,%lf].", argv[i], atof(argv[i+1]), parameters[j].dlb, parameters[j].dub);
     }
   }
 
@@ -315,9 +489,9 @@ int setParameters(int argc, char** argv, parametersT* param)
     else{
       // check if the stamp is valid
       char param_name[100];
-      char svalue[100];
+      char svalue[SCIP_MAXSTRLEN];
       while(!feof(fout)){
-        fscanf(fout,"%s", param_name);
+        fscanf(fout,"%99s", param_name);
         for(j=0;j<total_parameters && strcmp(param_name,parameters[j].param_name);j++)
           ;
         if(j>=total_parameters){
@@ -350,8 +524,9 @@ int setParameters(int argc, char** argv, parametersT* param)
             }
             break;
           case STRING:
-            fscanf(fout, "%s\n", svalue);
-            if(strcmp(svalue,*((char**)(parameters[j].param_var)))){
+            fscanf(fout, "%1023s\n", svalue); // SCIP_MAXSTRLEN-1
+            // strings not set are saved as (null)
+            if(strcmp(svalue,*((char**)(parameters[j].param_var)) ? *((char**)(parameters[j].param_var)) : "(null)")){
               printf("\nParameter (%s) value (%s) differs to saved value = %s.", param_name, svalue, *((char**)(parameters[j].param_var)));
               error = 1;
             }
@@ -364,41 +539,43 @@ int setParameters(int argc, char** argv, parametersT* param)
   }
   return !error;
 }
-// TODO: Get the best solution found and write the solution in a file. It depends on the problem!
-void printSol(SCIP* scip, char* outputname)
+// writes the labels (1..n) of the items of the solution
+void fprintSolItems(SCIP* scip, SCIP_SOL* bestSolution, FILE* file)
 {
    SCIP_PROBDATA* probdata;
-   SCIP_SOL* bestSolution;
    SCIP_VAR** vars;
    SCIP_Real solval;
-   FILE *file;
-   int v;//, nvars;
    instanceT* I;
-   char filename[SCIP_MAXSTRLEN];
-   const parametersT* param;
-   struct tm * ct;
-   const time_t t = time(NULL);
-   int sum;
+   int v, i;
 
-   assert(scip != NULL);
-   bestSolution = SCIPgetBestSol(scip);
-   if( bestSolution == NULL )
-     return;
    probdata = SCIPgetProbData(scip);
-   assert(probdata != NULL);
-
    I = SCIPprobdataGetInstance(probdata);
-   //   nvars = SCIPprobdataGetNVars(probdata);
    vars = SCIPprobdataGetVars(probdata);
-   param = SCIPprobdataGetParam(probdata);
-
-   (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s.sol", outputname);
-   file = fopen(filename, "w");
-   if(!file)
+   for( v=0; v< I->n; v++ ) // itens
      {
-       printf("\nProblem to create solution file: %s", filename);
-       return;
+       solval = SCIPgetSolVal(scip, bestSolution, vars[v]);
+       if( solval > EPSILON )
+	 {
+	   if(I->item[v].labels == NULL)
+	     fprintf(file, "%d ", I->item[v].label+1);
+	   else // merged items: the first copies of the group
+	     for(i=0;i<(int)(solval+EPSILON);i++)
+	       fprintf(file, "%d ", I->item[v].labels[i]+1);
+	 }
      }
+}
+// writes the solution in the format of the .sol file: z v d p r t in the first line and the items in the second one
+void fprintSol(SCIP* scip, SCIP_SOL* bestSolution, FILE* file)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_Real solval;
+   instanceT* I;
+   int v, sum;
+
+   probdata = SCIPgetProbData(scip);
+   I = SCIPprobdataGetInstance(probdata);
+   vars = SCIPprobdataGetVars(probdata);
 
      fprintf(file, "%d ", (int)(-SCIPsolGetOrigObj(bestSolution)+EPSILON)); // z
 
@@ -406,7 +583,7 @@ void printSol(SCIP* scip, char* outputname)
    for( v=0; v< I->n; v++ )
      {
        solval = SCIPgetSolVal(scip, bestSolution, vars[v]);
-       if( solval > EPSILON ) sum += I->item[v].value;	 
+       if( solval > EPSILON ) sum += I->item[v].value*(int)(solval+EPSILON);	 // copies of merged items
      }
     fprintf(file, "%d ", sum);
 
@@ -422,7 +599,7 @@ void printSol(SCIP* scip, char* outputname)
     for( v=0; v< I->n; v++ )
      {
        solval = SCIPgetSolVal(scip, bestSolution, vars[v]);
-       if( solval > EPSILON ) sum += I->item[v].weight;	 
+       if( solval > EPSILON ) sum += I->item[v].weight*(int)(solval+EPSILON);	 
      }
     fprintf(file, "%d ", sum);
 
@@ -430,7 +607,7 @@ void printSol(SCIP* scip, char* outputname)
     for( v=0; v< I->n; v++ )
      {
        solval = SCIPgetSolVal(scip, bestSolution, vars[v]);
-       if( solval > EPSILON ) sum += 1;	 
+       if( solval > EPSILON ) sum += (int)(solval+EPSILON);	 
      }
     fprintf(file, "%d ", sum);
 
@@ -442,15 +619,7 @@ void printSol(SCIP* scip, char* outputname)
      }
     fprintf(file, "%d\n", sum);
 
-   for( v=0; v< I->n; v++ ) // itens
-     {
-       solval = SCIPgetSolVal(scip, bestSolution, vars[v]);
-       if( solval > EPSILON )
-	 {
-	   fprintf(file, "%d ", I->item[v].label+1);
-	 }
-     }
-
+   fprintSolItems(scip, bestSolution, file);
 
    ///fprintf(file, "\nValue: %lf\nItems: ", -SCIPsolGetOrigObj(bestSolution));
 
@@ -464,6 +633,36 @@ void printSol(SCIP* scip, char* outputname)
      //}
 
    fprintf(file, "\n");
+}
+// TODO: Get the best solution found and write the solution in a file. It depends on the problem!
+void printSol(SCIP* scip, char* outputname)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_SOL* bestSolution;
+   FILE *file;
+   char filename[SCIP_MAXSTRLEN];
+   const parametersT* param;
+   struct tm * ct;
+   const time_t t = time(NULL);
+
+   assert(scip != NULL);
+   bestSolution = SCIPgetBestSol(scip);
+   if( bestSolution == NULL )
+     return;
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   param = SCIPprobdataGetParam(probdata);
+
+   (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s.sol", outputname);
+   file = fopen(filename, "w");
+   if(!file)
+     {
+       printf("\nProblem to create solution file: %s", filename);
+       return;
+     }
+
+   fprintSol(scip, bestSolution, file);
    //
    //fprintf(file, "Parameters settings file=%s\n", param->parameter_stamp);
    //fprintf(file, "Instance file=%s\n", SCIPgetProbName(scip));
@@ -494,16 +693,63 @@ void configOutputName(char* name, char* instance_filename, char* program, const
  // append program name and parameter stamp
   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s/%s-%s-%s", param->output_path,filename, program_filename, param->parameter_stamp);
 }
-/* sorteia um numero aleatorio entre [low,high] */
-int RandomInteger(int low, int high)
+/**
+ * set the parameters of a sub-SCIP used by a primal heuristic: no output, no node limit and no heuristics
+ */
+void configSubscipParam(parametersT* subparam, int time_limit)
+{
+   memset(subparam, 0, sizeof(parametersT));
+   subparam->time_limit = time_limit;
+   subparam->display_freq = -1;
+   subparam->nodes_limit = -1;
+}
+/**
+ * creates a solution for the original problem with the items in x (x[i]=1 if item i is selected, or the copies
+ * selected of a merged item) and
+ * the forfeit set variables v_j = max(0, total of selected items of the set j - h_j)
+ */
+SCIP_RETCODE createSolFromItems(SCIP* scip, SCIP_HEUR* heur, int* x, SCIP_SOL** sol)
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   instanceT* I;
+   int i, j, count;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+   vars = SCIPprobdataGetVars(probdata);
+   I = SCIPprobdataGetInstance(probdata);
+
+   SCIP_CALL( SCIPcreateSol(scip, sol, heur) );
+   for(i=0;i<I->n;i++){
+      if(x[i]){
+         SCIP_CALL( SCIPsetSolVal(scip, *sol, vars[i], (double) x[i]) );
+      }
+   }
+   for(j=0;j<I->nS;j++){
+      count = 0;
+      for(i=0;i<I->S[j].n;i++)
+         count += x[I->S[j].items[i]];
+      if(count > I->S[j].h){
+         SCIP_CALL( SCIPsetSolVal(scip, *sol, vars[I->n+j], (double) (count - I->S[j].h)) );
+      }
+   }
+   return SCIP_OKAY;
+}
+/* sorteia um numero aleatorio entre [low,high] (gerador do problema, ver SCIPprobdataGetRandnumgen()) */
+int RandomInteger(SCIP_RANDNUMGEN* randnumgen, int low, int high)
+{
+  return SCIPrandomGetInt(randnumgen, low, high);
+}
+/* sorteia um numero aleatorio em (0,1) */
+double RandomDouble(SCIP_RANDNUMGEN* randnumgen)
 {
-  int k;
   double d;
-  //  srand(time(NULL));
 
-  d = (double)rand() / ((double)RAND_MAX + 1);
-  k = d * (high - low + 1);
-  return low + k;
+  do{
+    d = SCIPrandomGetReal(randnumgen, 0.0, 1.0);
+  }while(d <= 0.0 || d >= 1.0);
+  return d;
 }
 // Função auxiliar de comparacao para o qsort
 int comparador(const void *valor1, const void *valor2)
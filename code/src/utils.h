@@ -5,18 +5,34 @@
 #include "problem.h"
 #include "probdata_mochila.h"
 #include "parameters_mochila.h"
+#include "run_mochila.h"
 #include "heur_aleatoria.h"
 #include "heur_rf.h"
 #include "heur_lns.h"
+#include "heur_pr.h"
+#include "heur_rins.h"
+#include "heur_lb.h"
+#include "event_elitepool.h"
+#include "event_timeline.h"
+#include "cons_forfeit.h"
+#include "prop_redcost.h"
+#include "sepa_forfeit.h"
+#include "branch_forfeit.h"
 SCIP_RETCODE SCIPtrySolMine(SCIP* scip, SCIP_SOL* sol, SCIP_Bool printreason, SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows, SCIP_Bool *stored);
 void removePath(char* fullfilename, char** filename);
 void configOutputName(char* name, char* instance_filename, char* program, const parametersT* param);
-SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname);
+SCIP_RETCODE printStatistic(SCIP* scip, double time, char* outputname, const phaseTimesT* phases);
 void printSol(SCIP* scip, char* outputname);
+void fprintSol(SCIP* scip, SCIP_SOL* sol, FILE* file);
+void fprintSolItems(SCIP* scip, SCIP_SOL* sol, FILE* file);
 SCIP_RETCODE configScip(SCIP** pscip, const parametersT* param);
+void configSubscipParam(parametersT* subparam, int time_limit);
+SCIP_RETCODE createSolFromItems(SCIP* scip, SCIP_HEUR* heur, int* x, SCIP_SOL** sol);
 //
 /* sorteia um numero aleatorio entre [low,high] */
-int RandomInteger(int low, int high);
+int RandomInteger(SCIP_RANDNUMGEN* randnumgen, int low, int high);
+/* sorteia um numero aleatorio em (0,1) */
+double RandomDouble(SCIP_RANDNUMGEN* randnumgen);
 /* put your local methods here, and declare them static */
 SCIP_RETCODE SCIPtrySolMine(SCIP* scip, SCIP_SOL* sol, SCIP_Bool printreason, SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows, SCIP_Bool *stored);
 int comparador(const void *valor1, const void *valor2);